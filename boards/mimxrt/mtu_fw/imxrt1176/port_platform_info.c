@@ -36,16 +36,30 @@
  * Definitions
  ******************************************************************************/
 
+//! @brief MPU region of XIP Flash in BOARD_ConfigMPU, unused when FW runs from RAM.
+#define BSP_MEM_ATTR_MPU_REGION (8U)
 
 /*******************************************************************************
  * Prototypes
  ******************************************************************************/
 
+static void bsp_rt_system_clean_dcache(void);
 
 /*******************************************************************************
  * Variables
  ******************************************************************************/
 
+//! @brief TEX/C/B of each bsp_mem_attr_t, as listed in BOARD_ConfigMPU.
+static const uint8_t s_memAttrTexCb[kBspMemAttr_MaxIdx][3] = {
+    {2, 0, 0}, // Device, not shareable
+    {1, 0, 0}, // Normal, outer and inner noncache
+    {0, 1, 0}, // Normal, outer and inner write through no write allocate
+    {1, 1, 1}, // Normal, outer and inner write back write/read allocate
+};
+
+static uint32_t s_memAttrSavedRbar;
+static uint32_t s_memAttrSavedRasr;
+static bool s_isMemAttrSaved;
 
 /*******************************************************************************
  * Code
@@ -84,9 +98,69 @@ void bsp_rt_system_srams_print(void)
     printf("   [0x%08X - 0x%08X], rw - usage rate %d%\n", dataStart, dataEnd, (dataEnd - dataStart)*100/(128*1024));
 }
 
+void bsp_rt_system_scratch_sram(uint32_t *start, uint32_t *size)
+{
+    // OCRAM2 is not used by FW (DATA2 region in linker file)
+    *start = 0x202C0000;
+    *size = 512 * 1024;
+}
 
 uint32_t bsp_life_timer_clocks_per_sec(void)
 {
     return CLOCK_GetRootClockFreq(kCLOCK_Root_Bus);
 }
 
+static void bsp_rt_system_clean_dcache(void)
+{
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+    // Lines of old attribute must not be written back or hit under new one
+    if (SCB_CCR_DC_Msk == (SCB_CCR_DC_Msk & SCB->CCR))
+    {
+        SCB_CleanInvalidateDCache();
+    }
+#endif
+}
+
+status_t bsp_rt_system_set_mem_attr(uint32_t start, uint32_t size, uint8_t memAttr)
+{
+    if ((!size) || (memAttr >= kBspMemAttr_MaxIdx))
+    {
+        return kStatus_InvalidArgument;
+    }
+    // Region size should be 2^N and base should be multiples of size, take the smallest one holding the range
+    uint32_t sizeLog2 = 5;
+    while ((sizeLog2 < 31) && ((start >> sizeLog2) != ((start + size - 1) >> sizeLog2)))
+    {
+        sizeLog2++;
+    }
+    uint32_t base = start & ~((1UL << sizeLog2) - 1);
+
+    if (!s_isMemAttrSaved)
+    {
+        MPU->RNR = BSP_MEM_ATTR_MPU_REGION;
+        s_memAttrSavedRbar = MPU->RBAR;
+        s_memAttrSavedRasr = MPU->RASR;
+        s_isMemAttrSaved = true;
+    }
+    bsp_rt_system_clean_dcache();
+    ARM_MPU_Disable();
+    ARM_MPU_SetRegionEx(BSP_MEM_ATTR_MPU_REGION, ARM_MPU_RBAR(BSP_MEM_ATTR_MPU_REGION, base),
+                        ARM_MPU_RASR(0, ARM_MPU_AP_FULL, s_memAttrTexCb[memAttr][0], 0, s_memAttrTexCb[memAttr][1],
+                                     s_memAttrTexCb[memAttr][2], 0, sizeLog2 - 1));
+    ARM_MPU_Enable(MPU_CTRL_PRIVDEFENA_Msk);
+
+    return kStatus_Success;
+}
+
+void bsp_rt_system_restore_mem_attr(void)
+{
+    if (!s_isMemAttrSaved)
+    {
+        return;
+    }
+    bsp_rt_system_clean_dcache();
+    ARM_MPU_Disable();
+    ARM_MPU_SetRegionEx(BSP_MEM_ATTR_MPU_REGION, s_memAttrSavedRbar & ~MPU_RBAR_VALID_Msk, s_memAttrSavedRasr);
+    ARM_MPU_Enable(MPU_CTRL_PRIVDEFENA_Msk);
+    s_isMemAttrSaved = false;
+}
@@ -216,6 +216,15 @@ enum _flexspi2_dqs_sel
 
 pin_info_t s_pinInfo[MTU_MAX_PINS];
 
+//! @brief Drive/slew candidates, bit0 is SRE and bit1 is DSE on GPIO_B1/B2/AD pads,
+//!        bit1 is PDRV (0: high drive) and bit0 is unused on GPIO_SD_B1/SD_B2 pads.
+static const bsp_pad_drive_option_t s_padDriveOptions[] = {
+    {"drv0 sre0", 0x3, 0x0},
+    {"drv0 sre1", 0x3, 0x1},
+    {"drv1 sre0", 0x3, 0x2},
+    {"drv1 sre1", 0x3, 0x3},
+};
+
 /*******************************************************************************
  * Code
  ******************************************************************************/
@@ -1858,3 +1867,8 @@ uint32_t bsp_mixspi_get_amba_base(void *config)
     }
 }
 
+uint32_t bsp_mixspi_get_pad_drive_options(const bsp_pad_drive_option_t **options)
+{
+    *options = s_padDriveOptions;
+    return ARRAY_SIZE(s_padDriveOptions);
+}
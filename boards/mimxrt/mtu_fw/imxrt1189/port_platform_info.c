@@ -8,6 +8,7 @@
  */
 #include "mtu.h"
 #include "clock_config.h"
+#include "fsl_cache.h"
 
 /*******************************************************************************
  * Declarations
@@ -36,16 +37,25 @@
  * Definitions
  ******************************************************************************/
 
+//! @brief First MPU region not used by BOARD_ConfigMPU, lower regions overlapping it are off while it is set.
+#define BSP_MEM_ATTR_MPU_REGION (9U)
 
 /*******************************************************************************
  * Prototypes
  ******************************************************************************/
 
+static void bsp_rt_system_clean_xcache(void);
 
 /*******************************************************************************
  * Variables
  ******************************************************************************/
 
+//! @brief MAIR attribute index of each bsp_mem_attr_t, as set up by BOARD_ConfigMPU.
+static const uint8_t s_memAttrIndex[kBspMemAttr_MaxIdx] = {0U, 1U, 2U, 3U};
+
+static uint32_t s_memAttrSavedRbar[BSP_MEM_ATTR_MPU_REGION + 1];
+static uint32_t s_memAttrSavedRlar[BSP_MEM_ATTR_MPU_REGION + 1];
+static bool s_isMemAttrSaved;
 
 /*******************************************************************************
  * Code
@@ -80,9 +90,81 @@ void bsp_rt_system_srams_print(void)
     printf("   [0x%08X - 0x%08X], rw - usage rate %d%\n", dataStart, dataEnd, (dataEnd - dataStart)*100/(128*1024));
 }
 
+void bsp_rt_system_scratch_sram(uint32_t *start, uint32_t *size)
+{
+    // OCRAM2 non-NCACHE part is not used by FW (DATA2 region in linker file)
+    *start = 0x20500000;
+    *size = 128 * 1024;
+}
 
 uint32_t bsp_life_timer_clocks_per_sec(void)
 {
     return CLOCK_GetRootClockFreq(kCLOCK_Root_Bus_Aon);
 }
 
+static void bsp_rt_system_clean_xcache(void)
+{
+    // Lines of old attribute must not be written back or hit under new one
+    if (XCACHE_CCR_ENCACHE_MASK == (XCACHE_CCR_ENCACHE_MASK & XCACHE_PC->CCR))
+    {
+        XCACHE_CleanInvalidateCache(XCACHE_PC);
+    }
+    if (XCACHE_CCR_ENCACHE_MASK == (XCACHE_CCR_ENCACHE_MASK & XCACHE_PS->CCR))
+    {
+        XCACHE_CleanInvalidateCache(XCACHE_PS);
+    }
+}
+
+status_t bsp_rt_system_set_mem_attr(uint32_t start, uint32_t size, uint8_t memAttr)
+{
+    if ((!size) || (memAttr >= kBspMemAttr_MaxIdx))
+    {
+        return kStatus_InvalidArgument;
+    }
+    // ARMv8-M regions are 32 bytes granular and must not overlap
+    uint32_t base = start & MPU_RBAR_BASE_Msk;
+    uint32_t limit = (start + size - 1) & MPU_RLAR_LIMIT_Msk;
+
+    if (!s_isMemAttrSaved)
+    {
+        for (uint32_t region = 0; region <= BSP_MEM_ATTR_MPU_REGION; region++)
+        {
+            MPU->RNR = region;
+            s_memAttrSavedRbar[region] = MPU->RBAR;
+            s_memAttrSavedRlar[region] = MPU->RLAR;
+        }
+        s_isMemAttrSaved = true;
+    }
+    bsp_rt_system_clean_xcache();
+    ARM_MPU_Disable();
+    for (uint32_t region = 0; region < BSP_MEM_ATTR_MPU_REGION; region++)
+    {
+        uint32_t rlar = s_memAttrSavedRlar[region];
+        if ((rlar & MPU_RLAR_EN_Msk) && ((s_memAttrSavedRbar[region] & MPU_RBAR_BASE_Msk) <= limit) &&
+            ((rlar & MPU_RLAR_LIMIT_Msk) >= base))
+        {
+            ARM_MPU_ClrRegion(region);
+        }
+    }
+    ARM_MPU_SetRegion(BSP_MEM_ATTR_MPU_REGION, ARM_MPU_RBAR(base, ARM_MPU_SH_NON, 0U, 1U, 1U),
+                      ARM_MPU_RLAR(limit, s_memAttrIndex[memAttr]));
+    ARM_MPU_Enable(MPU_CTRL_PRIVDEFENA_Msk);
+
+    return kStatus_Success;
+}
+
+void bsp_rt_system_restore_mem_attr(void)
+{
+    if (!s_isMemAttrSaved)
+    {
+        return;
+    }
+    bsp_rt_system_clean_xcache();
+    ARM_MPU_Disable();
+    for (uint32_t region = 0; region <= BSP_MEM_ATTR_MPU_REGION; region++)
+    {
+        ARM_MPU_SetRegion(region, s_memAttrSavedRbar[region], s_memAttrSavedRlar[region]);
+    }
+    ARM_MPU_Enable(MPU_CTRL_PRIVDEFENA_Msk);
+    s_isMemAttrSaved = false;
+}
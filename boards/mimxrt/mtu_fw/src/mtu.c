@@ -65,6 +65,7 @@ perf_test_packet_t s_perfTestPacket;
 /*! @brief Stress Test packet. */
 stress_test_packet_t s_stressTestPacket;
 int s_memtester_fail_stop;
+uint16_t s_memtester_test_mask;
 
 /*******************************************************************************
  * Code
@@ -398,10 +399,22 @@ static void mtu_command_execute(void)
             {
                 switch (s_perfTestPacket.testSet)
                 {
+#if MTU_FEATURE_PERF_TEST_COREMARK
                     case kPerfTestSet_Coremark:
+                        coremark_main(s_perfTestPacket.iterations,
+                                      s_perfTestPacket.memPlacement,
+                                      s_perfTestPacket.testMemStart,
+                                      s_perfTestPacket.testMemSize);
                         break;
+#endif
+#if MTU_FEATURE_PERF_TEST_DHRYSTONE
                     case kPerfTestSet_Dhrystone:
+                        dhrystone_main(s_perfTestPacket.iterations,
+                                       s_perfTestPacket.memPlacement,
+                                       s_perfTestPacket.testMemStart,
+                                       s_perfTestPacket.testMemSize);
                         break;
+#endif
 #if MTU_FEATURE_PERF_TEST_MBW
                     case kPerfTestSet_Mbw:
                         mbw_main(s_perfTestPacket.subTestSet - s_perfTestPacket.testSet, 
@@ -412,8 +425,76 @@ static void mtu_command_execute(void)
                                  s_perfTestPacket.testMemSize);
                         break;
 #endif
+#if MTU_FEATURE_PERF_TEST_SYSBENCH
                     case kPerfTestSet_Sysbench:
+                        mtu_sysbench_run(s_perfTestPacket.iterations,
+                                         s_perfTestPacket.subTestSet,
+                                         s_perfTestPacket.enableAverageShow,
+                                         s_perfTestPacket.testBlockSize,
+                                         s_perfTestPacket.testMemStart,
+                                         s_perfTestPacket.testMemSize);
+                        break;
+#endif
+#if MTU_FEATURE_PERF_TEST_NOR_SUSPEND
+                    case kPerfTestSet_NorSuspend:
+                        mtu_nor_suspend_run(s_perfTestPacket.iterations,
+                                            s_perfTestPacket.testBlockSize,
+                                            s_perfTestPacket.testMemStart,
+                                            s_perfTestPacket.testMemSize);
+                        break;
+#endif
+#if MTU_FEATURE_PERF_TEST_NOR_XIP
+                    case kPerfTestSet_NorXip:
+                        mtu_nor_xip_run(s_perfTestPacket.iterations,
+                                        s_perfTestPacket.testBlockSize,
+                                        s_perfTestPacket.testMemStart,
+                                        s_perfTestPacket.testMemSize);
+                        break;
+#endif
+#if MTU_FEATURE_PERF_TEST_NOR_READMODE
+                    case kPerfTestSet_NorReadMode:
+                        mtu_nor_readmode_run(s_perfTestPacket.iterations,
+                                             s_perfTestPacket.testMemStart,
+                                             s_perfTestPacket.testMemSize);
+                        break;
+#endif
+#if MTU_FEATURE_PERF_TEST_CLK_SHMOO
+                    case kPerfTestSet_ClkShmoo:
+                        // Block size field carries the highest clock point to try, in MHz
+                        mtu_clk_shmoo_run(s_perfTestPacket.iterations,
+                                          s_perfTestPacket.testBlockSize,
+                                          s_perfTestPacket.testMemStart,
+                                          s_perfTestPacket.testMemSize);
+                        break;
+                    case kPerfTestSet_PadShmoo:
+                        mtu_clk_shmoo_grid_run(s_perfTestPacket.iterations,
+                                               s_perfTestPacket.testBlockSize,
+                                               s_perfTestPacket.subTestSet != 0,
+                                               s_perfTestPacket.testMemStart,
+                                               s_perfTestPacket.testMemSize);
+                        break;
+#endif
+#if MTU_FEATURE_PERF_TEST_DLL_CALIB
+                    case kPerfTestSet_DllCalib:
+                        mtu_dll_calib_run(s_perfTestPacket.iterations,
+                                          s_perfTestPacket.testMemStart,
+                                          s_perfTestPacket.testMemSize);
+                        break;
+#endif
+#if MTU_FEATURE_PERF_TEST_AHB_BUF
+                    case kPerfTestSet_AhbBufSweep:
+                        mtu_ahb_buf_sweep_run(s_perfTestPacket.iterations,
+                                              s_perfTestPacket.testMemStart,
+                                              s_perfTestPacket.testMemSize);
                         break;
+#endif
+#if MTU_FEATURE_PERF_TEST_MEM_ATTR
+                    case kPerfTestSet_MemAttr:
+                        mtu_mem_attr_run(s_perfTestPacket.iterations,
+                                         s_perfTestPacket.testMemStart,
+                                         s_perfTestPacket.testMemSize);
+                        break;
+#endif
                     default:
                         break;
                 }
@@ -430,6 +511,7 @@ static void mtu_command_execute(void)
                         {
                             char memsuffix = 'B';
                             s_memtester_fail_stop = s_stressTestPacket.enableStopWhenFail;
+                            s_memtester_test_mask = s_stressTestPacket.option.memtesterMask;
                             memtester_main(s_stressTestPacket.testMemStart,
                                            s_stressTestPacket.testMemSize,
                                            &memsuffix,
@@ -437,6 +519,32 @@ static void mtu_command_execute(void)
                                            s_stressTestPacket.testPageSize);
                         }
                         break;
+#if MTU_FEATURE_STRESS_TEST_MARCH
+                    case kStressTestSet_March:
+                        mtu_march_run(s_stressTestPacket.option.march.algorithm,
+                                      s_stressTestPacket.option.march.option,
+                                      s_stressTestPacket.iterations,
+                                      s_stressTestPacket.enableStopWhenFail,
+                                      s_stressTestPacket.testMemStart,
+                                      s_stressTestPacket.testMemSize);
+                        break;
+#endif
+#if MTU_FEATURE_STRESS_TEST_PROBE
+                    case kStressTestSet_BusProbe:
+                        mtu_probe_run(s_stressTestPacket.iterations,
+                                      s_stressTestPacket.enableStopWhenFail,
+                                      s_stressTestPacket.testMemStart,
+                                      s_stressTestPacket.testMemSize);
+                        break;
+#endif
+#if MTU_FEATURE_STRESS_TEST_NOR
+                    case kStressTestSet_NorCycling:
+                        mtu_nor_stress_run(s_stressTestPacket.iterations,
+                                           s_stressTestPacket.enableStopWhenFail,
+                                           s_stressTestPacket.testMemStart,
+                                           s_stressTestPacket.testMemSize);
+                        break;
+#endif
                     default:
                         break;
                 }
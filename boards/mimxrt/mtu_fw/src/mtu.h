@@ -27,11 +27,51 @@
 #include "mtu_mem.h"
 #endif
 #if MTU_FEATURE_PERF_TEST
+#include "mtu_perf.h"
 #include "mbw.h"
 #endif
+#if MTU_FEATURE_PERF_TEST_COREMARK
+#include "core_portme.h"
+#endif
+#if MTU_FEATURE_PERF_TEST_DHRYSTONE
+#include "dhrystone.h"
+#endif
+#if MTU_FEATURE_PERF_TEST_SYSBENCH
+#include "mtu_sysbench.h"
+#endif
+#if MTU_FEATURE_PERF_TEST_NOR_SUSPEND
+#include "mtu_nor_suspend.h"
+#endif
+#if MTU_FEATURE_PERF_TEST_NOR_XIP
+#include "mtu_nor_xip.h"
+#endif
+#if MTU_FEATURE_PERF_TEST_NOR_READMODE
+#include "mtu_nor_readmode.h"
+#endif
+#if MTU_FEATURE_PERF_TEST_CLK_SHMOO
+#include "mtu_clk_shmoo.h"
+#endif
+#if MTU_FEATURE_PERF_TEST_DLL_CALIB
+#include "mtu_dll_calib.h"
+#endif
+#if MTU_FEATURE_PERF_TEST_AHB_BUF
+#include "mtu_ahb_buf.h"
+#endif
+#if MTU_FEATURE_PERF_TEST_MEM_ATTR
+#include "mtu_mem_attr.h"
+#endif
 #if MTU_FEATURE_STRESS_TEST
 #include "memtester.h"
 #endif
+#if MTU_FEATURE_STRESS_TEST_MARCH
+#include "mtu_march.h"
+#endif
+#if MTU_FEATURE_STRESS_TEST_PROBE
+#include "mtu_probe.h"
+#endif
+#if MTU_FEATURE_STRESS_TEST_NOR
+#include "mtu_nor_stress.h"
+#endif
 
 /*******************************************************************************
  * Definitions
@@ -127,6 +167,29 @@ enum _mem_types
 
 #define DEFAULT_PAD_CTRL_MAGIC (0xFFFFFFFFUL)
 
+//! @brief Values of enableL1Cache in config packet, 0 leaves caches as they are (field was ignored before).
+enum _l1_cache_ctrls
+{
+    kL1CacheCtrl_Unchanged = 0x00,
+    kL1CacheCtrl_Enable    = 0x01,    // Caches a previous packet turned off are back on
+    kL1CacheCtrl_Disable   = 0x02,    // Core caches off for all memory, FW code/data included
+};
+
+//! @brief Values of enablePreftech in config packet, 0 keeps driver default (field was ignored before).
+enum _ahb_prefetch_ctrls
+{
+    kAhbPrefetchCtrl_Default = 0x00,  // Prefetch on, as FLEXSPI driver default config sets it
+    kAhbPrefetchCtrl_Enable  = 0x01,
+    kAhbPrefetchCtrl_Disable = 0x02,
+};
+
+//! @brief Fields of ahbBufMaster/ahbBufAlignment in config packet.
+#define AHB_BUF_MASTER_ID_MASK        (0x0FU)
+#define AHB_BUF_MASTER_PRIORITY_SHIFT (4U)
+#define AHB_BUF_MASTER_PRIORITY_MASK  (0x70U)
+#define AHB_BUF_ALIGNMENT_MASK        (0x03U)
+#define AHB_BUF_VALID_MASK            (0x80U)
+
 //! @brief Flexspi pin pad ctrl.
 typedef struct _flexspi_padctrl
 {
@@ -150,20 +213,21 @@ typedef struct _memory_property
     uint8_t ioPadsMode;
     uint8_t interfaceMode;
     uint8_t sampleRateMode;
-    uint8_t reserved0;
+    uint8_t flashSfdpMode;      // 1: SPI NOR LUT, QE, size and timing derived from SFDP, 0: host memLut only
     uint16_t flashQuadEnableCfg;
     uint8_t  flashQuadEnableBytes;
-    uint8_t  reserved1;
+    uint8_t  flashSizeLog2;     // log2 of NOR size in bytes, 0: JEDEC capacity ID (QuadSPI) or 16 MB
     uint32_t memLut[CUSTOM_LUT_LENGTH];
 } memory_property_t;
 
 typedef struct _config_system_packet
 {
     uint16_t cpuSpeedMHz;
-    uint8_t enableL1Cache;
-    uint8_t enablePreftech;
-    uint16_t prefetchBufSizeInByte;
-    uint8_t reserved0[2];
+    uint8_t enableL1Cache;              // _l1_cache_ctrls
+    uint8_t enablePreftech;             // _ahb_prefetch_ctrls
+    uint16_t prefetchBufSizeInByte;     // AHB RX buffer of ahbBufMaster if valid, or of all masters, 0: default
+    uint8_t ahbBufMaster;               // [3:0] AHB master ID given a dedicated RX buffer, [6:4] its priority, [7] valid
+    uint8_t ahbBufAlignment;            // [1:0] AHBCR ALIGNMENT, [7] valid, 0: 1KB
     flexspi_connection_t memConnection;
     flexspi_padctrl_t padCtrl;
     memory_property_t memProperty;
@@ -198,6 +262,14 @@ enum _perf_test_sets
     kPerfTestSet_Dhrystone       = 0xB0,
     kPerfTestSet_Mbw             = 0xC0,
     kPerfTestSet_Sysbench        = 0xD0,
+    kPerfTestSet_NorSuspend      = 0x90,
+    kPerfTestSet_NorXip          = 0x91,
+    kPerfTestSet_NorReadMode     = 0x92,
+    kPerfTestSet_ClkShmoo        = 0x93,
+    kPerfTestSet_PadShmoo        = 0x94,
+    kPerfTestSet_DllCalib        = 0x95,
+    kPerfTestSet_AhbBufSweep     = 0x96,
+    kPerfTestSet_MemAttr         = 0x97,
 
     kPerfTestSubSet_Memcpy       = 0xC1,
     kPerfTestSubSet_Dumb         = 0xC2,
@@ -207,16 +279,27 @@ enum _perf_test_sets
     kInvalidPerfTestSet          = 0xFF,
 };
 
+//! @brief Perf-Test code/data placement codes.
+enum _perf_mem_placements
+{
+    kPerfMemPlacement_Tcm        = 0x00,    // Link-time placement (ITCM/DTCM)
+    kPerfMemPlacement_Ocram      = 0x01,    // Free OCRAM reported by BSP
+    kPerfMemPlacement_ExtMem     = 0x02,    // Configured FlexSPI memory, from testMemStart
+    kPerfMemPlacement_MaxIdx,
+};
+
 typedef struct _perf_test_packet
 {
     uint8_t testSet;
-    uint8_t subTestSet;
-    uint8_t enableAverageShow;
-    uint8_t reserved0;
+    uint8_t subTestSet;         // Sysbench: read percent of transfers, 0 for default, 0xFF for writes only;
+                                // PadShmoo: 1 sweeps read sample clock too
+    uint8_t enableAverageShow;  // Sysbench: compute rounds per transfer
+    uint8_t memPlacement;       // [3:0] code placement, [7:4] data placement
     uint32_t iterations;
     uint32_t testMemStart;
     uint32_t testMemSize;
-    uint32_t testBlockSize;
+    uint32_t testBlockSize;     // Sysbench: max transfer size; NorSuspend: erase time before suspend in us;
+                                // NorXip: bytes read after every page program; Clk/PadShmoo: max root clock in MHz
     uint16_t crcCheckSum;
     uint8_t reserved1[2];
 } perf_test_packet_t;
@@ -225,6 +308,9 @@ typedef struct _perf_test_packet
 enum _stress_test_sets
 {
     kStressTestSet_Memtester     = 0xE0,
+    kStressTestSet_March         = 0xE1,
+    kStressTestSet_BusProbe      = 0xE2,
+    kStressTestSet_NorCycling    = 0xE3,
 
     //! Maximum linearly incrementing Stress-Test code value.
     kInvalidStressTestSet        = 0xFF,
@@ -234,7 +320,15 @@ typedef struct _stress_test_packet
 {
     uint8_t testSet;
     uint8_t enableStopWhenFail;
-    uint8_t reserved0[2];
+    union
+    {
+        struct
+        {
+            uint8_t algorithm;  // see _march_algorithms
+            uint8_t option;     // [3:0] word width in bytes, [7:4] address order
+        } march;
+        uint16_t memtesterMask; // see MEMTESTER_PACKET_MASK_*, 0 runs all tests
+    } option;
     uint32_t iterations;
     uint32_t testMemStart;
     uint32_t testMemSize;
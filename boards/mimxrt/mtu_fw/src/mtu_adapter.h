@@ -34,6 +34,20 @@
 #define MIXSPI_Type                  XSPI_Type
 #endif
 
+//! @brief AHB master ID value of a shared-only RX buffer layout.
+#define MIXSPI_AHB_BUF_NO_MASTER (0xFF)
+
+// AHB RX buffer partition, taken from config packet
+typedef struct _mixspi_ahb_buf_config
+{
+    bool     enablePrefetch;
+    uint8_t  alignment;         // AHBCR ALIGNMENT, 0: no limit, 1: 1KB, 2: 4KB, 3: 8KB
+    uint8_t  masterId;          // Master with a dedicated buffer, MIXSPI_AHB_BUF_NO_MASTER: none
+    uint8_t  masterPriority;    // 0 lowest
+    uint16_t masterBufSize;     // Bytes, multiple of 8
+    uint16_t sharedBufSize;     // Bytes of buffer for all other masters, 0: driver default
+} mixspi_ahb_buf_config_t;
+
 // mem property info for operation
 typedef struct _mixspi_user_config
 {
@@ -43,11 +57,12 @@ typedef struct _mixspi_user_config
     mixspi_root_clk_freq_t      mixspiRootClkFreq;
     mixspi_read_sample_clock_t  mixspiReadSampleClock;
     const uint32_t             *mixspiCustomLUTVendor;
+    mixspi_ahb_buf_config_t     ahbBufConfig;
 
     uint8_t  flashBusyStatusPol;
     uint8_t  flashBusyStatusOffset;
     uint8_t  flashMixStatusMask;
-    uint8_t  reserved;
+    uint8_t  flashErrorStatusMask;     // Status bits of erase/program failure (non-HyperFlash), 0 disables check
 } mixspi_user_config_t;
 
 /*******************************************************************************
@@ -0,0 +1,148 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "mtu.h"
+#include "fsl_cache.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+//! @brief Result of one partition, over all rounds.
+typedef struct _ahb_buf_result
+{
+    uint64_t seqCycles;
+    uint64_t randomCycles;
+    uint32_t seqBytes;
+    uint32_t randomReads;
+} ahb_buf_result_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+static void mtu_ahb_buf_measure(uint32_t ambaAddr, uint32_t size, uint32_t rounds, ahb_buf_result_t *result);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+//! @brief Candidates, buffer sizes fit MIXSPI_AHB_RX_BUF_TOTAL_SIZE with the 256 bytes buffer of master 0.
+static const ahb_buf_partition_t s_ahbBufPartitions[] = {
+    {"no prefetch", false, 1, 0, 0},
+    {"default", true, 1, 0, 0},
+    {"shared 512B", true, 1, 512, 0},
+    {"shared 768B", true, 1, 768, 0},
+    {"align none", true, 0, 0, 0},
+    {"align 4KB", true, 2, 0, 0},
+    {"align 8KB", true, 3, 0, 0},
+    {"master 256B", true, 1, 0, 256},
+    {"master 512B", true, 1, 0, 512},
+};
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static void mtu_ahb_buf_measure(uint32_t ambaAddr, uint32_t size, uint32_t rounds, ahb_buf_result_t *result)
+{
+    for (uint32_t round = 0; round < rounds; round++)
+    {
+#if defined(MTU_CACHE_MAINTAIN) && MTU_CACHE_MAINTAIN
+        // Reads must be served by AHB RX buffers or the device, not by L1 cache
+        DCACHE_InvalidateByRange(ambaAddr, size);
+#endif
+        uint32_t cycles = mtu_cycle_timer_count();
+        mtu_perf_read_seq(ambaAddr, size);
+        result->seqCycles += mtu_cycle_timer_count() - cycles;
+        result->seqBytes += size;
+
+#if defined(MTU_CACHE_MAINTAIN) && MTU_CACHE_MAINTAIN
+        DCACHE_InvalidateByRange(ambaAddr, size);
+#endif
+        cycles = mtu_cycle_timer_count();
+        mtu_perf_read_random(ambaAddr, size, MTU_AHB_BUF_LATENCY_READS);
+        result->randomCycles += mtu_cycle_timer_count() - cycles;
+        result->randomReads += MTU_AHB_BUF_LATENCY_READS;
+    }
+}
+
+status_t mtu_ahb_buf_sweep_run(uint32_t rounds, uint32_t memStart, uint32_t memSize)
+{
+    printf("Arg List: rounds=%d, memStart=0x%x, memSize=0x%x.\n", rounds, memStart, memSize);
+
+    if (s_configSystemPacket.memProperty.type == kMemType_InternalSRAM)
+    {
+        printf("AHB buffer sweep only runs on external memory.\r\n");
+        return kStatus_InvalidArgument;
+    }
+    if (memSize < 4)
+    {
+        printf("Test memory region is too small.\r\n");
+        return kStatus_InvalidArgument;
+    }
+    if (!rounds)
+    {
+        rounds = 1;
+    }
+    uint32_t size = ((memSize > MTU_AHB_BUF_MAX_SIZE) ? MTU_AHB_BUF_MAX_SIZE : memSize) & ~3UL;
+    uint32_t ambaAddr = mtu_memory_convert_to_offset_addr(memStart) + bsp_mixspi_get_amba_base(&s_userConfig);
+    mixspi_ahb_buf_config_t hostAhbBuf = s_userConfig.ahbBufConfig;
+    bool hasMaster = (hostAhbBuf.masterId != MIXSPI_AHB_BUF_NO_MASTER);
+
+    mtu_perf_timebase_start();
+    float cyclesPerUs = (float)mtu_cycle_timer_clocks_per_sec() / 1000000;
+    printf("%-14s %10s %14s\r\n", "Partition", "Seq MB/s", "Random ns");
+    for (uint32_t idx = 0; idx <= ARRAY_SIZE(s_ahbBufPartitions); idx++)
+    {
+        // Entry 0 is the layout host configured
+        const char *name = "host";
+        mixspi_ahb_buf_config_t *ahbBuf = &s_userConfig.ahbBufConfig;
+        *ahbBuf = hostAhbBuf;
+        if (idx)
+        {
+            const ahb_buf_partition_t *partition = &s_ahbBufPartitions[idx - 1];
+            if (partition->masterBufSize && !hasMaster)
+            {
+                continue;
+            }
+            name = partition->name;
+            ahbBuf->enablePrefetch = partition->enablePrefetch;
+            ahbBuf->alignment = partition->alignment;
+            ahbBuf->sharedBufSize = partition->sharedBufSize;
+            ahbBuf->masterBufSize = partition->masterBufSize;
+            if (!partition->masterBufSize)
+            {
+                ahbBuf->masterId = MIXSPI_AHB_BUF_NO_MASTER;
+            }
+        }
+        mtu_mixspi_set_ahb_buffer(&s_userConfig);
+
+        ahb_buf_result_t result = {0};
+        mtu_ahb_buf_measure(ambaAddr, size, rounds, &result);
+        printf("%-14s %10.2f %14.1f\r\n", name, (float)result.seqBytes / ((float)result.seqCycles / cyclesPerUs),
+               (float)result.randomCycles * 1000 / cyclesPerUs / result.randomReads);
+    }
+    mtu_perf_timebase_stop();
+
+    s_userConfig.ahbBufConfig = hostAhbBuf;
+    mtu_mixspi_set_ahb_buffer(&s_userConfig);
+    if (hasMaster)
+    {
+        printf("Dedicated buffers serve AHB master %d with priority %d.\r\n", hostAhbBuf.masterId,
+               hostAhbBuf.masterPriority);
+    }
+    else
+    {
+        printf("No AHB master in config packet, dedicated buffer partitions are skipped.\r\n");
+    }
+    printf("0x%x bytes per pass, %d random reads, %d passes per partition.\r\n", size, MTU_AHB_BUF_LATENCY_READS,
+           rounds);
+
+    printf("Done and Passed!\r\n");
+    return kStatus_Success;
+}
@@ -0,0 +1,39 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _MTU_AHB_BUF_H_
+#define _MTU_AHB_BUF_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "fsl_common.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+//! @brief Region streamed for bandwidth, and hit by random reads for latency.
+#define MTU_AHB_BUF_MAX_SIZE      (0x10000)
+#define MTU_AHB_BUF_LATENCY_READS (1024)
+
+//! @brief One AHB RX buffer partition candidate, dedicated master comes from config packet.
+typedef struct _ahb_buf_partition
+{
+    const char *name;
+    bool enablePrefetch;
+    uint8_t alignment;
+    uint16_t sharedBufSize;
+    uint16_t masterBufSize;     // 0: no dedicated buffer
+} ahb_buf_partition_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+status_t mtu_ahb_buf_sweep_run(uint32_t rounds, uint32_t memStart, uint32_t memSize);
+
+#endif /* _MTU_AHB_BUF_H_ */
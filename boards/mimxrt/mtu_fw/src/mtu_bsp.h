@@ -42,6 +42,24 @@ typedef struct PinInfo
 
 #define MTU_MAX_PINS (22)
 
+//! @brief One pad drive/slew candidate, applied to a pad config as (padCtrl & ~mask) | value.
+typedef struct _bsp_pad_drive_option
+{
+    const char *name;
+    uint32_t mask;
+    uint32_t value;
+} bsp_pad_drive_option_t;
+
+//! @brief MPU attribute of external memory window, see BOARD_ConfigMPU of each board.
+typedef enum _bsp_mem_attr
+{
+    kBspMemAttr_Device       = 0,
+    kBspMemAttr_NonCacheable = 1,
+    kBspMemAttr_WriteThrough = 2,
+    kBspMemAttr_WriteBack    = 3,
+    kBspMemAttr_MaxIdx,
+} bsp_mem_attr_t;
+
 /*******************************************************************************
  * API
  ******************************************************************************/
@@ -60,6 +78,8 @@ void     bsp_mixspi_sw_delay_us(uint64_t us);
 
 uint32_t bsp_mixspi_get_amba_base(void *config);
 
+uint32_t bsp_mixspi_get_pad_drive_options(const bsp_pad_drive_option_t **options);
+
 void     bsp_adc_echo_info(void);
 
 void     bsp_adc_init(void);
@@ -74,4 +94,10 @@ void     bsp_rt_system_clocks_print(void);
 
 void     bsp_rt_system_srams_print(void);
 
+void     bsp_rt_system_scratch_sram(uint32_t *start, uint32_t *size);
+
+status_t bsp_rt_system_set_mem_attr(uint32_t start, uint32_t size, uint8_t memAttr);
+
+void     bsp_rt_system_restore_mem_attr(void);
+
 #endif /* __MTU_BSP__ */
@@ -0,0 +1,350 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "mtu.h"
+#include "fsl_cache.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+typedef struct _clk_shmoo_sample_clk
+{
+    const char *name;
+    mixspi_read_sample_clock_t source;
+} clk_shmoo_sample_clk_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+static void mtu_clk_shmoo_apply_pads(const flexspi_padctrl_t *hostPadCtrl, const bsp_pad_drive_option_t *option);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static clk_shmoo_result_t s_clkShmooResult[MTU_CLK_SHMOO_POINTS];
+
+//! @brief Third axis of pad shmoo, host configured source is used if it is not swept.
+static const clk_shmoo_sample_clk_t s_clkShmooSampleClks[] = {
+    {"loopback internally", kFLEXSPI_ReadSampleClkLoopbackInternally},
+    {"loopback from DQS pad", kFLEXSPI_ReadSampleClkLoopbackFromDqsPad},
+    {"loopback from SCK pad", kFLEXSPI_ReadSampleClkLoopbackFromSckPad},
+    {"external DQS", kFLEXSPI_ReadSampleClkExternalInputFromDqsPad},
+};
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+void mtu_clk_shmoo_test_point(uint32_t ambaAddr, uint32_t size, uint32_t rounds, bool isWritable,
+                              clk_shmoo_result_t *result)
+{
+    for (uint32_t round = 0; round < rounds; round++)
+    {
+        // RAM gets a new pattern every round, so data left by a previous point cannot pass
+        uint32_t seed = isWritable ? (round + 1) * 0x01010101UL : 0;
+        uint32_t cycles;
+        if (isWritable)
+        {
+            cycles = mtu_cycle_timer_count();
+            for (uint32_t offset = 0; offset < size; offset += 4)
+            {
+                *(volatile uint32_t *)(ambaAddr + offset) = mtu_memory_pattern_word(offset, seed);
+            }
+#if defined(MTU_CACHE_MAINTAIN) && MTU_CACHE_MAINTAIN
+            DCACHE_CleanInvalidateByRange(ambaAddr, size);
+#endif
+            result->writeCycles += mtu_cycle_timer_count() - cycles;
+        }
+#if defined(MTU_CACHE_MAINTAIN) && MTU_CACHE_MAINTAIN
+        // Verify must sample the bus at the clock under test
+        DCACHE_InvalidateByRange(ambaAddr, size);
+#endif
+        cycles = mtu_cycle_timer_count();
+        result->errors += mtu_memory_verify_pattern(ambaAddr, size, seed);
+        result->readCycles += mtu_cycle_timer_count() - cycles;
+        result->bytes += size;
+    }
+}
+
+status_t mtu_clk_shmoo_prepare(uint32_t memStart, uint32_t memSize, clk_shmoo_region_t *region)
+{
+    uint8_t memType = s_configSystemPacket.memProperty.type;
+    if (memType == kMemType_InternalSRAM)
+    {
+        printf("Shmoo only runs on external memory.\r\n");
+        return kStatus_InvalidArgument;
+    }
+    region->isFlash = (memType <= kMemType_FlashMaxIdx);
+    uint32_t offsetAddr = mtu_memory_convert_to_offset_addr(memStart);
+    if (region->isFlash && ((offsetAddr & (MTU_MEM_NOR_SECTOR_SIZE - 1)) || (memSize < MTU_MEM_NOR_SECTOR_SIZE)))
+    {
+        printf("Test memory region must be aligned with flash sector and contain one sector at least.\r\n");
+        return kStatus_InvalidArgument;
+    }
+    if (memSize < 4)
+    {
+        printf("Test memory region is too small.\r\n");
+        return kStatus_InvalidArgument;
+    }
+    region->size = (memSize > MTU_CLK_SHMOO_MAX_SIZE) ? MTU_CLK_SHMOO_MAX_SIZE : memSize;
+    region->size &= region->isFlash ? ~(MTU_MEM_NOR_SECTOR_SIZE - 1) : ~3UL;
+    region->ambaAddr = offsetAddr + bsp_mixspi_get_amba_base(&s_userConfig);
+
+    if (region->isFlash)
+    {
+        // Program is not part of the shmoo, it is done once at the slowest point
+        mixspi_root_clk_freq_t hostClkFreq = (mixspi_root_clk_freq_t)s_userConfig.mixspiRootClkFreq;
+        mtu_memory_set_root_clk(kMixspiRootClkFreq_30MHz);
+        status_t status = mtu_memory_program_nor_pattern(offsetAddr, region->size);
+        mtu_memory_set_root_clk(hostClkFreq);
+        if (status != kStatus_Success)
+        {
+            return status;
+        }
+    }
+
+    return kStatus_Success;
+}
+
+static void mtu_clk_shmoo_apply_pads(const flexspi_padctrl_t *hostPadCtrl, const bsp_pad_drive_option_t *option)
+{
+    // Pads left at default by host start from 0, only option bits are then meaningful
+    const uint32_t *hostPads = (const uint32_t *)hostPadCtrl;
+    uint32_t *pads = (uint32_t *)&s_configSystemPacket.padCtrl;
+    for (uint32_t idx = 0; idx < sizeof(flexspi_padctrl_t) / 4; idx++)
+    {
+        if (&pads[idx] == &s_configSystemPacket.padCtrl.rst_b)
+        {
+            continue;
+        }
+        uint32_t padCtrl = (hostPads[idx] == DEFAULT_PAD_CTRL_MAGIC) ? 0 : hostPads[idx];
+        pads[idx] = (padCtrl & ~option->mask) | option->value;
+    }
+    bsp_mixspi_pinmux_config(&s_configSystemPacket, false);
+}
+
+status_t mtu_clk_shmoo_run(uint32_t rounds, uint32_t maxClkMHz, uint32_t memStart, uint32_t memSize)
+{
+    printf("Arg List: rounds=%d, maxClkMHz=%d, memStart=0x%x, memSize=0x%x.\n", rounds, maxClkMHz, memStart,
+           memSize);
+
+    clk_shmoo_region_t region;
+    status_t status = mtu_clk_shmoo_prepare(memStart, memSize, &region);
+    if (status != kStatus_Success)
+    {
+        printf("Done and Failed!\r\n");
+        return status;
+    }
+    if (!rounds)
+    {
+        rounds = 1;
+    }
+    if (!maxClkMHz)
+    {
+        maxClkMHz = g_mixspiRootClkFreqInMHz[kMixspiRootClkFreq_400MHz];
+    }
+    mixspi_root_clk_freq_t hostClkFreq = (mixspi_root_clk_freq_t)s_userConfig.mixspiRootClkFreq;
+
+    memset(s_clkShmooResult, 0, sizeof(s_clkShmooResult));
+    mtu_perf_timebase_start();
+    for (uint32_t clkFreq = kMixspiRootClkFreq_30MHz; clkFreq < MTU_CLK_SHMOO_POINTS; clkFreq++)
+    {
+        if (g_mixspiRootClkFreqInMHz[clkFreq] > maxClkMHz)
+        {
+            break;
+        }
+        clk_shmoo_result_t *result = &s_clkShmooResult[clkFreq];
+        result->actualClkHz = mtu_memory_set_root_clk((mixspi_root_clk_freq_t)clkFreq);
+        result->isTried = true;
+        mtu_clk_shmoo_test_point(region.ambaAddr, region.size, rounds, !region.isFlash, result);
+    }
+    mtu_memory_set_root_clk(hostClkFreq);
+    float cyclesPerUs = (float)mtu_cycle_timer_clocks_per_sec() / 1000000;
+    mtu_perf_timebase_stop();
+
+    // Max stable is the top of the passing range that starts from the slowest point
+    uint32_t maxStableFreq = 0;
+    bool isStableRange = true;
+    printf("%-8s %10s %8s %12s %12s\r\n", "Point", "Actual MHz", "Result", "Write MB/s", "Read MB/s");
+    for (uint32_t clkFreq = kMixspiRootClkFreq_30MHz; clkFreq < MTU_CLK_SHMOO_POINTS; clkFreq++)
+    {
+        clk_shmoo_result_t *result = &s_clkShmooResult[clkFreq];
+        if (!result->isTried)
+        {
+            break;
+        }
+        float readMBps = (float)result->bytes / ((float)result->readCycles / cyclesPerUs);
+        printf("%5dMHz %10d %8s ", g_mixspiRootClkFreqInMHz[clkFreq], result->actualClkHz / 1000000,
+               result->errors ? "FAIL" : "pass");
+        if (result->writeCycles)
+        {
+            printf("%12.2f ", (float)result->bytes / ((float)result->writeCycles / cyclesPerUs));
+        }
+        else
+        {
+            printf("%12s ", "-");
+        }
+        printf("%12.2f\r\n", readMBps);
+        if (result->errors)
+        {
+            isStableRange = false;
+        }
+        else if (isStableRange)
+        {
+            maxStableFreq = clkFreq;
+        }
+    }
+    printf("0x%x bytes per pass, %d passes per point.\r\n", region.size, rounds);
+
+    if (!maxStableFreq)
+    {
+        printf("Memory failed at the slowest clock point.\r\n");
+        printf("Done and Failed!\r\n");
+        return kStatus_Fail;
+    }
+    printf("Max stable FlexSPI root clock: %dMHz, host configured %dMHz.\r\n",
+           g_mixspiRootClkFreqInMHz[maxStableFreq], g_mixspiRootClkFreqInMHz[hostClkFreq]);
+    if (s_clkShmooResult[hostClkFreq].isTried && s_clkShmooResult[hostClkFreq].errors)
+    {
+        printf("Host configured clock is out of stable range.\r\n");
+        printf("Done and Failed!\r\n");
+        return kStatus_Fail;
+    }
+
+    printf("Done and Passed!\r\n");
+    return kStatus_Success;
+}
+
+status_t mtu_clk_shmoo_grid_run(uint32_t rounds, uint32_t maxClkMHz, bool isSampleClkSwept, uint32_t memStart,
+                                uint32_t memSize)
+{
+    printf("Arg List: rounds=%d, maxClkMHz=%d, isSampleClkSwept=%d, memStart=0x%x, memSize=0x%x.\n", rounds,
+           maxClkMHz, isSampleClkSwept, memStart, memSize);
+
+    const bsp_pad_drive_option_t *padOptions;
+    uint32_t padOptionCount = bsp_mixspi_get_pad_drive_options(&padOptions);
+    if (padOptionCount > MTU_CLK_SHMOO_MAX_PAD_OPTIONS)
+    {
+        padOptionCount = MTU_CLK_SHMOO_MAX_PAD_OPTIONS;
+    }
+    clk_shmoo_region_t region;
+    status_t status = mtu_clk_shmoo_prepare(memStart, memSize, &region);
+    if ((status != kStatus_Success) || !padOptionCount)
+    {
+        printf("Done and Failed!\r\n");
+        return (status != kStatus_Success) ? status : kStatus_Fail;
+    }
+    if (!rounds)
+    {
+        rounds = 1;
+    }
+    if (!maxClkMHz)
+    {
+        maxClkMHz = g_mixspiRootClkFreqInMHz[kMixspiRootClkFreq_400MHz];
+    }
+    mixspi_root_clk_freq_t hostClkFreq = (mixspi_root_clk_freq_t)s_userConfig.mixspiRootClkFreq;
+    mixspi_read_sample_clock_t hostSampleClk = s_userConfig.mixspiReadSampleClock;
+    flexspi_padctrl_t hostPadCtrl = s_configSystemPacket.padCtrl;
+    uint32_t sampleClkCount = isSampleClkSwept ? ARRAY_SIZE(s_clkShmooSampleClks) : 1;
+
+    uint32_t bestMaxStableFreq = 0;
+    uint32_t bestPadOption = 0;
+    uint32_t bestSampleClk = 0;
+    mtu_perf_timebase_start();
+    float cyclesPerUs = (float)mtu_cycle_timer_clocks_per_sec() / 1000000;
+    for (uint32_t sampleIdx = 0; sampleIdx < sampleClkCount; sampleIdx++)
+    {
+        if (isSampleClkSwept)
+        {
+            mtu_memory_set_read_sample_clk(s_clkShmooSampleClks[sampleIdx].source);
+            printf("Read sample clock: %s\r\n", s_clkShmooSampleClks[sampleIdx].name);
+        }
+        // Grid is streamed row by row, cell is read MB/s of a passing point
+        printf("%-8s", "Point");
+        for (uint32_t padIdx = 0; padIdx < padOptionCount; padIdx++)
+        {
+            printf(" %10s", padOptions[padIdx].name);
+        }
+        printf("\r\n");
+
+        uint32_t maxStableFreq[MTU_CLK_SHMOO_MAX_PAD_OPTIONS] = {0};
+        bool isStableRange[MTU_CLK_SHMOO_MAX_PAD_OPTIONS];
+        memset(isStableRange, true, sizeof(isStableRange));
+        for (uint32_t clkFreq = kMixspiRootClkFreq_30MHz; clkFreq < MTU_CLK_SHMOO_POINTS; clkFreq++)
+        {
+            if (g_mixspiRootClkFreqInMHz[clkFreq] > maxClkMHz)
+            {
+                break;
+            }
+            mtu_memory_set_root_clk((mixspi_root_clk_freq_t)clkFreq);
+            printf("%5dMHz ", g_mixspiRootClkFreqInMHz[clkFreq]);
+            for (uint32_t padIdx = 0; padIdx < padOptionCount; padIdx++)
+            {
+                clk_shmoo_result_t result = {0};
+                mtu_clk_shmoo_apply_pads(&hostPadCtrl, &padOptions[padIdx]);
+                mtu_clk_shmoo_test_point(region.ambaAddr, region.size, rounds, !region.isFlash, &result);
+                if (result.errors)
+                {
+                    printf(" %10s", "FAIL");
+                    isStableRange[padIdx] = false;
+                }
+                else
+                {
+                    printf(" %10.2f", (float)result.bytes / ((float)result.readCycles / cyclesPerUs));
+                    if (isStableRange[padIdx])
+                    {
+                        maxStableFreq[padIdx] = clkFreq;
+                    }
+                }
+            }
+            printf("\r\n");
+        }
+
+        printf("%-8s", "Max MHz");
+        for (uint32_t padIdx = 0; padIdx < padOptionCount; padIdx++)
+        {
+            printf(" %10d", g_mixspiRootClkFreqInMHz[maxStableFreq[padIdx]]);
+            if (maxStableFreq[padIdx] > bestMaxStableFreq)
+            {
+                bestMaxStableFreq = maxStableFreq[padIdx];
+                bestPadOption = padIdx;
+                bestSampleClk = sampleIdx;
+            }
+        }
+        printf("\r\n");
+    }
+    mtu_perf_timebase_stop();
+
+    s_configSystemPacket.padCtrl = hostPadCtrl;
+    bsp_mixspi_pinmux_config(&s_configSystemPacket, false);
+    if (isSampleClkSwept)
+    {
+        mtu_memory_set_read_sample_clk(hostSampleClk);
+    }
+    mtu_memory_set_root_clk(hostClkFreq);
+    printf("0x%x bytes per pass, %d passes per point.\r\n", region.size, rounds);
+
+    if (!bestMaxStableFreq)
+    {
+        printf("No pad setting passed at the slowest clock point.\r\n");
+        printf("Done and Failed!\r\n");
+        return kStatus_Fail;
+    }
+    printf("Widest stable range: up to %dMHz with pads %s", g_mixspiRootClkFreqInMHz[bestMaxStableFreq],
+           padOptions[bestPadOption].name);
+    if (isSampleClkSwept)
+    {
+        printf(", %s", s_clkShmooSampleClks[bestSampleClk].name);
+    }
+    printf(".\r\n");
+
+    printf("Done and Passed!\r\n");
+    return kStatus_Success;
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _MTU_CLK_SHMOO_H_
+#define _MTU_CLK_SHMOO_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "fsl_common.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+//! @brief Region written/verified and timed at every clock point.
+#define MTU_CLK_SHMOO_MAX_SIZE (0x10000)
+
+//! @brief One entry per mixspi_root_clk_freq_t value, index 0 is unused.
+#define MTU_CLK_SHMOO_POINTS (kMixspiRootClkFreq_400MHz + 1)
+
+//! @brief Pad drive/slew columns of one grid, extra BSP options are ignored.
+#define MTU_CLK_SHMOO_MAX_PAD_OPTIONS (8)
+
+//! @brief Result of one clock point.
+typedef struct _clk_shmoo_result
+{
+    uint32_t actualClkHz;   // Root clock got from BSP, may differ from requested point
+    uint32_t errors;        // Mismatched words over all rounds
+    uint32_t bytes;
+    uint64_t readCycles;
+    uint64_t writeCycles;   // 0 for NOR Flash, pattern is programmed once
+    bool isTried;
+} clk_shmoo_result_t;
+
+//! @brief Test region, NOR Flash holds the pattern programmed by prepare.
+typedef struct _clk_shmoo_region
+{
+    uint32_t ambaAddr;
+    uint32_t size;
+    bool isFlash;
+} clk_shmoo_region_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+status_t mtu_clk_shmoo_prepare(uint32_t memStart, uint32_t memSize, clk_shmoo_region_t *region);
+
+void mtu_clk_shmoo_test_point(uint32_t ambaAddr, uint32_t size, uint32_t rounds, bool isWritable,
+                              clk_shmoo_result_t *result);
+
+status_t mtu_clk_shmoo_run(uint32_t rounds, uint32_t maxClkMHz, uint32_t memStart, uint32_t memSize);
+
+status_t mtu_clk_shmoo_grid_run(uint32_t rounds, uint32_t maxClkMHz, bool isSampleClkSwept, uint32_t memStart,
+                                uint32_t memSize);
+
+#endif /* _MTU_CLK_SHMOO_H_ */
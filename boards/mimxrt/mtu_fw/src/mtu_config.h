@@ -22,6 +22,11 @@
  * CPU core accesses the memory, not cache only.
  */
 #define MTU_CACHE_MAINTAIN       (1)
+/*
+ * Flash erase/program only invalidates the AMBA range it changed, batched per sector,
+ * instead of disabling and re-enabling the whole L1 cache around every operation.
+ */
+#define MTU_CACHE_MAINTAIN_BY_RANGE (1)
 
 #define MTU_FEATURE_PACKET_CRC   (1)
 
@@ -29,6 +34,19 @@
 #define MTU_FEATURE_EXT_MEMORY      (1)
 #define MTU_FEATURE_PERF_TEST       (1)
 #define MTU_FEATURE_PERF_TEST_MBW   (1)
+#define MTU_FEATURE_PERF_TEST_COREMARK (1)
+#define MTU_FEATURE_PERF_TEST_DHRYSTONE (1)
+#define MTU_FEATURE_PERF_TEST_SYSBENCH (1)
+#define MTU_FEATURE_PERF_TEST_NOR_SUSPEND (1)
+#define MTU_FEATURE_PERF_TEST_NOR_XIP (1)
+#define MTU_FEATURE_PERF_TEST_NOR_READMODE (1)
+#define MTU_FEATURE_PERF_TEST_CLK_SHMOO (1)
+#define MTU_FEATURE_PERF_TEST_DLL_CALIB (1)
+#define MTU_FEATURE_PERF_TEST_AHB_BUF (1)
+#define MTU_FEATURE_PERF_TEST_MEM_ATTR (1)
 #define MTU_FEATURE_STRESS_TEST     (1)
+#define MTU_FEATURE_STRESS_TEST_MARCH (1)
+#define MTU_FEATURE_STRESS_TEST_PROBE (1)
+#define MTU_FEATURE_STRESS_TEST_NOR (1)
 
 #endif /* _MTU_CONFIG_H_ */
@@ -0,0 +1,204 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "mtu.h"
+#include "mtu_clk_shmoo.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+//! @brief Root clock from which FlexSPI driver runs DLL instead of override.
+#define MTU_DLL_CALIB_DLL_MODE_MIN_CLK (100000000UL)
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+static bool mtu_dll_calib_apply(uint32_t dllValue);
+
+static bool mtu_dll_calib_test(const clk_shmoo_region_t *region, uint32_t rounds, uint32_t dllValue);
+
+static void mtu_dll_calib_find_window(const bool *isPassed, uint32_t count, dll_calib_window_t *window);
+
+static void mtu_dll_calib_print_eye(const char *name, const bool *isPassed, uint32_t count);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static bool s_dllCalibSlavePassed[MTU_DLL_CALIB_SLAVE_TARGETS];
+
+static bool s_dllCalibOverridePassed[MTU_DLL_CALIB_OVERRIDE_VALUES];
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static bool mtu_dll_calib_apply(uint32_t dllValue)
+{
+    FLEXSPI_Type *base = s_userConfig.mixspiBase;
+    uint32_t index = (uint32_t)s_userConfig.mixspiPort >> 1; /* PortA with index 0, PortB with index 1. */
+    uint32_t lockMask = index ? (FLEXSPI_STS2_BSLVLOCK_MASK | FLEXSPI_STS2_BREFLOCK_MASK) :
+                                (FLEXSPI_STS2_ASLVLOCK_MASK | FLEXSPI_STS2_AREFLOCK_MASK);
+    bool isLocked = true;
+
+    /* Wait for bus to be idle before changing DLL. */
+    while (!FLEXSPI_GetBusIdleStatus(base))
+    {
+    }
+    base->DLLCR[index] = dllValue;
+    if (dllValue & FLEXSPI_DLLCR_DLLEN_MASK)
+    {
+        // A target out of DLL range never locks, it must not hang the sweep
+        uint32_t timeout = MTU_DLL_CALIB_LOCK_TIMEOUT;
+        while (((base->STS2 & lockMask) != lockMask) && --timeout)
+        {
+        }
+        isLocked = (timeout != 0);
+
+        /* According to ERR011377, need to delay at least 100 NOPs to ensure the DLL is locked. */
+        for (uint32_t delay = 100; delay > 0; delay--)
+        {
+            __NOP();
+        }
+    }
+    FLEXSPI_SoftwareReset(base);
+
+    return isLocked;
+}
+
+static bool mtu_dll_calib_test(const clk_shmoo_region_t *region, uint32_t rounds, uint32_t dllValue)
+{
+    if (!mtu_dll_calib_apply(dllValue))
+    {
+        return false;
+    }
+    clk_shmoo_result_t result = {0};
+    mtu_clk_shmoo_test_point(region->ambaAddr, region->size, rounds, !region->isFlash, &result);
+
+    return (result.errors == 0);
+}
+
+static void mtu_dll_calib_find_window(const bool *isPassed, uint32_t count, dll_calib_window_t *window)
+{
+    memset(window, 0, sizeof(*window));
+    uint32_t runStart = 0;
+    for (uint32_t idx = 0; idx < count; idx++)
+    {
+        if (!isPassed[idx])
+        {
+            runStart = idx + 1;
+            continue;
+        }
+        window->passCount++;
+        if (idx + 1 - runStart > window->width)
+        {
+            window->start = (uint8_t)runStart;
+            window->width = (uint8_t)(idx + 1 - runStart);
+        }
+    }
+}
+
+static void mtu_dll_calib_print_eye(const char *name, const bool *isPassed, uint32_t count)
+{
+    printf("%-22s (0-%d): ", name, count - 1);
+    for (uint32_t idx = 0; idx < count; idx++)
+    {
+        printf("%c", isPassed[idx] ? 'o' : '.');
+    }
+    printf("\r\n");
+}
+
+status_t mtu_dll_calib_run(uint32_t rounds, uint32_t memStart, uint32_t memSize)
+{
+    printf("Arg List: rounds=%d, memStart=0x%x, memSize=0x%x.\n", rounds, memStart, memSize);
+
+    clk_shmoo_region_t region;
+    status_t status = mtu_clk_shmoo_prepare(memStart, memSize, &region);
+    if (status != kStatus_Success)
+    {
+        printf("Done and Failed!\r\n");
+        return status;
+    }
+    if (!rounds)
+    {
+        rounds = 1;
+    }
+    FLEXSPI_Type *base = s_userConfig.mixspiBase;
+    uint32_t hostDllValue = base->DLLCR[(uint32_t)s_userConfig.mixspiPort >> 1];
+    uint32_t rootClkHz = bsp_mixspi_get_clock(&s_userConfig);
+
+    // Sample point only moves the read capture, RAM writes of every setting land the same
+    mtu_perf_timebase_start();
+    for (uint32_t target = 0; target < MTU_DLL_CALIB_SLAVE_TARGETS; target++)
+    {
+        s_dllCalibSlavePassed[target] =
+            mtu_dll_calib_test(&region, rounds, FLEXSPI_DLLCR_DLLEN(1) | FLEXSPI_DLLCR_SLVDLYTARGET(target));
+    }
+    for (uint32_t cells = 0; cells < MTU_DLL_CALIB_OVERRIDE_VALUES; cells++)
+    {
+        s_dllCalibOverridePassed[cells] =
+            mtu_dll_calib_test(&region, rounds, FLEXSPI_DLLCR_OVRDEN(1) | FLEXSPI_DLLCR_OVRDVAL(cells));
+    }
+
+    dll_calib_window_t slaveWindow;
+    dll_calib_window_t overrideWindow;
+    mtu_dll_calib_find_window(s_dllCalibSlavePassed, MTU_DLL_CALIB_SLAVE_TARGETS, &slaveWindow);
+    mtu_dll_calib_find_window(s_dllCalibOverridePassed, MTU_DLL_CALIB_OVERRIDE_VALUES, &overrideWindow);
+    printf("Data eye at FlexSPI root clock %dMHz, host DLLCR 0x%x ('o': pass):\r\n", rootClkHz / 1000000,
+           hostDllValue);
+    mtu_dll_calib_print_eye("Slave delay target", s_dllCalibSlavePassed, MTU_DLL_CALIB_SLAVE_TARGETS);
+    mtu_dll_calib_print_eye("Override delay cells", s_dllCalibOverridePassed, MTU_DLL_CALIB_OVERRIDE_VALUES);
+
+    // Same mode as FlexSPI driver picks for this clock, the other one only if it has no window
+    bool isDllMode = (rootClkHz >= MTU_DLL_CALIB_DLL_MODE_MIN_CLK);
+    if ((isDllMode && !slaveWindow.width) || (!isDllMode && !overrideWindow.width))
+    {
+        isDllMode = !isDllMode;
+    }
+    dll_calib_window_t *window = isDllMode ? &slaveWindow : &overrideWindow;
+    if (!window->width)
+    {
+        mtu_dll_calib_apply(hostDllValue);
+        mtu_perf_timebase_stop();
+        printf("No DLL setting returned correct data.\r\n");
+        printf("Done and Failed!\r\n");
+        return kStatus_Fail;
+    }
+    uint32_t centre = window->start + window->width / 2;
+    uint32_t dllValue = isDllMode ? (FLEXSPI_DLLCR_DLLEN(1) | FLEXSPI_DLLCR_SLVDLYTARGET(centre)) :
+                                    (FLEXSPI_DLLCR_OVRDEN(1) | FLEXSPI_DLLCR_OVRDVAL(centre));
+    bool isCentrePassed = mtu_dll_calib_test(&region, rounds, dllValue);
+    mtu_perf_timebase_stop();
+
+    if (isDllMode)
+    {
+        // Slave delay target steps are 1/32 of reference clock cycle
+        printf("Window: slave delay target %d-%d, width %d steps (~%d ps).\r\n", window->start,
+               window->start + window->width - 1, window->width,
+               (uint32_t)((uint64_t)window->width * 1000000000000ULL / rootClkHz / 32));
+    }
+    else
+    {
+        printf("Window: override %d-%d cells, width %d cells (%d-%d ps), centre ~%d ns data valid time.\r\n",
+               window->start, window->start + window->width - 1, window->width,
+               window->width * MTU_DLL_CALIB_DELAY_CELL_MIN_PS, window->width * MTU_DLL_CALIB_DELAY_CELL_MAX_PS,
+               centre * MTU_DLL_CALIB_DELAY_CELL_MIN_PS / 1000);
+    }
+    if (!isCentrePassed)
+    {
+        mtu_dll_calib_apply(hostDllValue);
+        printf("Eye centre failed on recheck, host DLL setting is kept.\r\n");
+        printf("Done and Failed!\r\n");
+        return kStatus_Fail;
+    }
+    printf("DLLCR programmed to 0x%x, it holds until next root clock change.\r\n", dllValue);
+
+    printf("Done and Passed!\r\n");
+    return kStatus_Success;
+}
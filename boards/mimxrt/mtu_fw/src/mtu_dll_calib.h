@@ -0,0 +1,45 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _MTU_DLL_CALIB_H_
+#define _MTU_DLL_CALIB_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "fsl_common.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+//! @brief Settings of DLLCR, SLVDLYTARGET with DLL enabled and OVRDVAL with override enabled.
+#define MTU_DLL_CALIB_SLAVE_TARGETS   (16)
+#define MTU_DLL_CALIB_OVERRIDE_VALUES (64)
+
+//! @brief Delay cell of override mode, as FlexSPI driver assumes (ps).
+#define MTU_DLL_CALIB_DELAY_CELL_MIN_PS (75)
+#define MTU_DLL_CALIB_DELAY_CELL_MAX_PS (225)
+
+//! @brief STS2 polls before a DLL setting is given up as unlocked.
+#define MTU_DLL_CALIB_LOCK_TIMEOUT (100000)
+
+//! @brief Passing window of one DLL mode, in setting steps.
+typedef struct _dll_calib_window
+{
+    uint8_t start;
+    uint8_t width;
+    uint8_t passCount;
+    uint8_t reserved;
+} dll_calib_window_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+status_t mtu_dll_calib_run(uint32_t rounds, uint32_t memStart, uint32_t memSize);
+
+#endif /* _MTU_DLL_CALIB_H_ */
@@ -0,0 +1,98 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <ctype.h>
+#include <stdio.h>
+#include "clock_config.h"
+#include "mtu.h"
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+//! @brief Upper 32bits of the extended cycle counter and last seen CYCCNT value.
+static uint32_t s_cycleCntHigh;
+static uint32_t s_cycleCntLast;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+void mtu_cycle_timer_init(void)
+{
+    // Enable trace and debug block, it is required by DWT
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+#if defined(__CORE_CM7_H_GENERIC)
+    // Unlock DWT registers, only needed on CM7
+    DWT->LAR = 0xC5ACCE55;
+#endif
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    s_cycleCntHigh = 0;
+    s_cycleCntLast = 0;
+}
+
+void mtu_cycle_timer_deinit(void)
+{
+    DWT->CTRL &= ~DWT_CTRL_CYCCNTENA_Msk;
+}
+
+void mtu_cycle_timer_ensure_running(void)
+{
+    // Free running counter for instrumentation, an ongoing measurement is not reset
+    if (!(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk))
+    {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+#if defined(__CORE_CM7_H_GENERIC)
+        DWT->LAR = 0xC5ACCE55;
+#endif
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+}
+
+uint64_t mtu_cycle_timer_clock(void)
+{
+    // CYCCNT is only 32bit wide (~4s at 1GHz), so it must be sampled at least once
+    //  per wrap period, either by caller or by a periodic task (see mtu_cycle_timer_update)
+    uint32_t primask = DisableGlobalIRQ();
+    uint32_t cycleCnt = DWT->CYCCNT;
+    if (cycleCnt < s_cycleCntLast)
+    {
+        s_cycleCntHigh++;
+    }
+    s_cycleCntLast = cycleCnt;
+    uint64_t clocks = ((uint64_t)s_cycleCntHigh << 32) | cycleCnt;
+    EnableGlobalIRQ(primask);
+
+    return clocks;
+}
+
+uint32_t mtu_cycle_timer_count(void)
+{
+    // Raw 32bit counter, it is cheap enough to time short intervals (< one wrap period)
+    return DWT->CYCCNT;
+}
+
+void mtu_cycle_timer_update(void)
+{
+    (void)mtu_cycle_timer_clock();
+}
+
+uint32_t mtu_cycle_timer_clocks_per_sec(void)
+{
+    return SystemCoreClock;
+}
@@ -0,0 +1,281 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "mtu.h"
+#include "fsl_cache.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define MTU_MARCH_MAX_ELEMENTS     (6)
+#define MTU_MARCH_MAX_ELEMENT_OPS  (5)
+
+//! @brief Operations of march element, 0/1 is the data background (all 0s or all 1s).
+enum _march_ops
+{
+    kMarchOp_W0 = 0x00,
+    kMarchOp_W1 = 0x01,
+    kMarchOp_R0 = 0x02,
+    kMarchOp_R1 = 0x03,
+};
+
+//! @brief Address direction of march element.
+enum _march_directions
+{
+    kMarchDir_Any  = 0x00,
+    kMarchDir_Up   = 0x01,
+    kMarchDir_Down = 0x02,
+};
+
+typedef struct _march_element
+{
+    uint8_t direction;
+    uint8_t opCount;
+    uint8_t ops[MTU_MARCH_MAX_ELEMENT_OPS];
+} march_element_t;
+
+typedef struct _march_algorithm
+{
+    const char *name;
+    uint8_t elementCount;
+    march_element_t elements[MTU_MARCH_MAX_ELEMENTS];
+} march_algorithm_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+static inline uint32_t mtu_march_read(uint32_t addr, uint8_t wordBytes);
+
+static inline void mtu_march_write(uint32_t addr, uint8_t wordBytes, uint32_t value);
+
+static uint32_t mtu_march_run_element(const march_element_t *element, uint32_t elementIdx, uint8_t wordBytes,
+                                      uint8_t addrOrder, bool stopWhenFail, uint32_t memStart, uint32_t wordCount);
+
+static void mtu_march_print_element(const march_element_t *element);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static const march_algorithm_t s_marchAlgorithms[kMarchAlgorithm_MaxIdx] = {
+    // MATS+: {any(w0); up(r0,w1); down(r1,w0)}
+    {"MATS+", 3,
+     {{kMarchDir_Any, 1, {kMarchOp_W0}},
+      {kMarchDir_Up, 2, {kMarchOp_R0, kMarchOp_W1}},
+      {kMarchDir_Down, 2, {kMarchOp_R1, kMarchOp_W0}}}},
+    // March C-: {any(w0); up(r0,w1); up(r1,w0); down(r0,w1); down(r1,w0); any(r0)}
+    {"March C-", 6,
+     {{kMarchDir_Any, 1, {kMarchOp_W0}},
+      {kMarchDir_Up, 2, {kMarchOp_R0, kMarchOp_W1}},
+      {kMarchDir_Up, 2, {kMarchOp_R1, kMarchOp_W0}},
+      {kMarchDir_Down, 2, {kMarchOp_R0, kMarchOp_W1}},
+      {kMarchDir_Down, 2, {kMarchOp_R1, kMarchOp_W0}},
+      {kMarchDir_Any, 1, {kMarchOp_R0}}}},
+    // March SS: {any(w0); up(r0,r0,w0,r0,w1); up(r1,r1,w1,r1,w0);
+    //            down(r0,r0,w0,r0,w1); down(r1,r1,w1,r1,w0); any(r0)}
+    {"March SS", 6,
+     {{kMarchDir_Any, 1, {kMarchOp_W0}},
+      {kMarchDir_Up, 5, {kMarchOp_R0, kMarchOp_R0, kMarchOp_W0, kMarchOp_R0, kMarchOp_W1}},
+      {kMarchDir_Up, 5, {kMarchOp_R1, kMarchOp_R1, kMarchOp_W1, kMarchOp_R1, kMarchOp_W0}},
+      {kMarchDir_Down, 5, {kMarchOp_R0, kMarchOp_R0, kMarchOp_W0, kMarchOp_R0, kMarchOp_W1}},
+      {kMarchDir_Down, 5, {kMarchOp_R1, kMarchOp_R1, kMarchOp_W1, kMarchOp_R1, kMarchOp_W0}},
+      {kMarchDir_Any, 1, {kMarchOp_R0}}}},
+};
+
+static const char *const s_marchDirName[] = {"any", "up", "down"};
+static const char *const s_marchOpName[] = {"w0", "w1", "r0", "r1"};
+static const char *const s_marchAddrOrderName[kMarchAddrOrder_MaxIdx] = {"linear", "address complement"};
+
+//! @brief Failures of current run, shared by all elements.
+static uint32_t s_marchFailures;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static inline uint32_t mtu_march_read(uint32_t addr, uint8_t wordBytes)
+{
+    switch (wordBytes)
+    {
+        case 1:
+            return *(volatile uint8_t *)addr;
+        case 2:
+            return *(volatile uint16_t *)addr;
+        default:
+            return *(volatile uint32_t *)addr;
+    }
+}
+
+static inline void mtu_march_write(uint32_t addr, uint8_t wordBytes, uint32_t value)
+{
+    switch (wordBytes)
+    {
+        case 1:
+            *(volatile uint8_t *)addr = (uint8_t)value;
+            break;
+        case 2:
+            *(volatile uint16_t *)addr = (uint16_t)value;
+            break;
+        default:
+            *(volatile uint32_t *)addr = value;
+            break;
+    }
+}
+
+static uint32_t mtu_march_run_element(const march_element_t *element, uint32_t elementIdx, uint8_t wordBytes,
+                                      uint8_t addrOrder, bool stopWhenFail, uint32_t memStart, uint32_t wordCount)
+{
+    uint32_t ones = (wordBytes == 4) ? 0xFFFFFFFFUL : ((1UL << (wordBytes * 8)) - 1);
+    bool isDown = (element->direction == kMarchDir_Down);
+
+    for (uint32_t k = 0; k < wordCount; k++)
+    {
+        uint32_t seq = isDown ? (wordCount - 1 - k) : k;
+        uint32_t index = seq;
+        if (addrOrder == kMarchAddrOrder_Complement)
+        {
+            index = (seq & 1) ? (wordCount - 1 - (seq >> 1)) : (seq >> 1);
+        }
+        uint32_t addr = memStart + index * wordBytes;
+
+        for (uint32_t opIdx = 0; opIdx < element->opCount; opIdx++)
+        {
+            uint8_t op = element->ops[opIdx];
+            uint32_t value = (op & 0x1) ? ones : 0;
+            if (op < kMarchOp_R0)
+            {
+                mtu_march_write(addr, wordBytes, value);
+                continue;
+            }
+            uint32_t actual = mtu_march_read(addr, wordBytes);
+            if (actual != value)
+            {
+                s_marchFailures++;
+                if (s_marchFailures <= MTU_MARCH_MAX_REPORTED_FAILURES)
+                {
+                    printf("FAILURE: M%d op%d(%s) 0x%08x != 0x%08x at address 0x%08x.\r\n", elementIdx, opIdx,
+                           s_marchOpName[op], actual, value, addr);
+                }
+                if (stopWhenFail)
+                {
+                    return s_marchFailures;
+                }
+            }
+        }
+    }
+
+    return s_marchFailures;
+}
+
+static void mtu_march_print_element(const march_element_t *element)
+{
+    printf("%s(", s_marchDirName[element->direction]);
+    for (uint32_t opIdx = 0; opIdx < element->opCount; opIdx++)
+    {
+        printf(opIdx ? ",%s" : "%s", s_marchOpName[element->ops[opIdx]]);
+    }
+    printf(")");
+}
+
+status_t mtu_march_run(uint8_t algorithm, uint8_t marchOption, uint32_t loops, bool stopWhenFail,
+                       uint32_t memStart, uint32_t memSize)
+{
+    uint8_t wordBytes = MTU_MARCH_WORD_BYTES(marchOption);
+    uint8_t addrOrder = MTU_MARCH_ADDR_ORDER(marchOption);
+    printf("Arg List: algorithm=%d, wordBytes=%d, addrOrder=%d, loops=%d, fail_stop=%d, memStart=0x%x, memSize=0x%x.\n",
+           algorithm, wordBytes, addrOrder, loops, stopWhenFail, memStart, memSize);
+
+    if (!wordBytes)
+    {
+        wordBytes = 4;
+    }
+    if ((algorithm >= kMarchAlgorithm_MaxIdx) || (addrOrder >= kMarchAddrOrder_MaxIdx) ||
+        ((wordBytes != 1) && (wordBytes != 2) && (wordBytes != 4)))
+    {
+        printf("Invalid march algorithm/option.\r\n");
+        return kStatus_InvalidArgument;
+    }
+    if ((memStart & (wordBytes - 1)) || (memSize < wordBytes))
+    {
+        printf("Test memory region must be aligned with word width.\r\n");
+        return kStatus_InvalidArgument;
+    }
+#if MTU_FEATURE_EXT_MEMORY
+    if (s_configSystemPacket.memProperty.type <= kMemType_FlashMaxIdx)
+    {
+        printf("NOR Flash is not writable by CPU, march test is not supported.\r\n");
+        return kStatus_InvalidArgument;
+    }
+#endif
+    if (!loops)
+    {
+        loops = 1;
+    }
+
+    const march_algorithm_t *march = &s_marchAlgorithms[algorithm];
+    uint32_t wordCount = memSize / wordBytes;
+    uint32_t opsPerWord = 0;
+    printf("%s: {", march->name);
+    for (uint32_t elementIdx = 0; elementIdx < march->elementCount; elementIdx++)
+    {
+        printf(elementIdx ? "; " : "");
+        mtu_march_print_element(&march->elements[elementIdx]);
+        opsPerWord += march->elements[elementIdx].opCount;
+    }
+    printf("}, %dn, %d-bit words, %s order\r\n", opsPerWord, wordBytes * 8, s_marchAddrOrderName[addrOrder]);
+
+    s_marchFailures = 0;
+    mtu_perf_timebase_start();
+    uint64_t startTime = mtu_cycle_timer_clock();
+    for (uint32_t loop = 1; loop <= loops; loop++)
+    {
+        printf("Loop %d/%d:\r\n", loop, loops);
+        for (uint32_t elementIdx = 0; elementIdx < march->elementCount; elementIdx++)
+        {
+            const march_element_t *element = &march->elements[elementIdx];
+            uint32_t failures = s_marchFailures;
+            uint64_t elementTime = mtu_cycle_timer_clock();
+            mtu_march_run_element(element, elementIdx, wordBytes, addrOrder, stopWhenFail, memStart, wordCount);
+#if defined(MTU_CACHE_MAINTAIN) && MTU_CACHE_MAINTAIN
+            // Next element must read back from memory, not from cache
+            DCACHE_CleanInvalidateByRange(memStart, memSize);
+#endif
+            elementTime = mtu_cycle_timer_clock() - elementTime;
+            printf("  M%d ", elementIdx);
+            mtu_march_print_element(element);
+            printf(": %s (%d ms)\r\n", (failures == s_marchFailures) ? "ok" : "failed",
+                   (uint32_t)(elementTime * 1000 / mtu_cycle_timer_clocks_per_sec()));
+            if (stopWhenFail && s_marchFailures)
+            {
+                break;
+            }
+        }
+        if (stopWhenFail && s_marchFailures)
+        {
+            break;
+        }
+    }
+    uint64_t totalTime = mtu_cycle_timer_clock() - startTime;
+    mtu_perf_timebase_stop();
+
+    if (s_marchFailures > MTU_MARCH_MAX_REPORTED_FAILURES)
+    {
+        printf("%d more failures are not printed.\r\n", s_marchFailures - MTU_MARCH_MAX_REPORTED_FAILURES);
+    }
+    printf("Total time %d ms, %d failures\r\n", (uint32_t)(totalTime * 1000 / mtu_cycle_timer_clocks_per_sec()),
+           s_marchFailures);
+    if (s_marchFailures)
+    {
+        printf("Done and Failed!\r\n");
+        return kStatus_Fail;
+    }
+
+    printf("Done and Passed!\r\n");
+    return kStatus_Success;
+}
@@ -0,0 +1,50 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _MTU_MARCH_H_
+#define _MTU_MARCH_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "fsl_common.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+//! @brief Only first failures are printed, the rest are just counted.
+#define MTU_MARCH_MAX_REPORTED_FAILURES (16)
+
+//! @brief March algorithm codes.
+enum _march_algorithms
+{
+    kMarchAlgorithm_MatsPlus    = 0x00,    // 5n, stuck-at and address faults
+    kMarchAlgorithm_CMinus      = 0x01,    // 10n, adds transition and coupling faults
+    kMarchAlgorithm_SS          = 0x02,    // 22n, adds static simple faults (read destructive, etc.)
+    kMarchAlgorithm_MaxIdx,
+};
+
+//! @brief Address order codes, the same order is reversed for descending elements.
+enum _march_addr_orders
+{
+    kMarchAddrOrder_Linear      = 0x00,    // 0, 1, 2, ..., n-1
+    kMarchAddrOrder_Complement  = 0x01,    // 0, n-1, 1, n-2, ..., toggles all address lines for decoder faults
+    kMarchAddrOrder_MaxIdx,
+};
+
+//! @brief Get word width (in bytes)/address order from stress test packet option.march.option field.
+#define MTU_MARCH_WORD_BYTES(x)     ((x) & 0x0F)
+#define MTU_MARCH_ADDR_ORDER(x)     (((x) >> 4) & 0x0F)
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+status_t mtu_march_run(uint8_t algorithm, uint8_t marchOption, uint32_t loops, bool stopWhenFail,
+                       uint32_t memStart, uint32_t memSize);
+
+#endif /* _MTU_MARCH_H_ */
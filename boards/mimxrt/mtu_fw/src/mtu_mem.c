@@ -13,11 +13,25 @@
  * Definitions
  ******************************************************************************/
 
+//! @brief Pattern writer state, it hands out the pattern of next program command.
+typedef struct _mem_pattern_source
+{
+    uint32_t offset;
+} mem_pattern_source_t;
 
 /*******************************************************************************
  * Prototypes
  ******************************************************************************/
 
+static status_t mtu_memory_set_nor_size(void);
+
+static void mtu_memory_apply_nor_family(const nor_device_family_t *family);
+
+static void mtu_memory_get_ahb_buf_config(mixspi_ahb_buf_config_t *ahbBuf);
+
+static void mtu_memory_apply_l1_cache(void);
+
+static uint32_t mtu_memory_fetch_offset_pattern(void *context, uint32_t maxLen, const uint8_t **data);
 
 /*******************************************************************************
  * Variables
@@ -27,6 +41,11 @@ mixspi_user_config_t s_userConfig;
 
 uint32_t s_memRwBuffer[0x200/4];
 
+//! @brief Caches turned off for the run, board init left them enabled.
+static mixspi_cache_status_t s_memL1CacheStatus;
+
+static uint32_t s_memPatternBuffer[MTU_MEM_NOR_PAGE_SIZE / 4];
+
 /* Common FlexSPI config */
 flexspi_device_config_t s_nordeviceconfig = {
     .flexspiRootClk       = 30000000,
@@ -131,6 +150,11 @@ status_t mtu_memory_init(void)
 {
     status_t status;
     uint32_t jedecID = 0;
+    // Device of previous config goes back to reset address mode, new LUT may send 3-byte address
+    mtu_mixspi_nor_exit_4byte_mode(&s_userConfig);
+    // JEDEC size is valid only for the config that reads the ID
+    mtu_flash_clear_mem_size();
+    mtu_memory_apply_l1_cache();
     if (s_configSystemPacket.memProperty.type == kMemType_InternalSRAM)
     {
         printf("Internal SRAM does not need to be configured.\r\n");
@@ -138,11 +162,15 @@ status_t mtu_memory_init(void)
     }
     
     s_userConfig.mixspiRootClkFreq = mtu_flash_convert_root_clk(s_configSystemPacket.memProperty.speedMHz);
+    // Operation timing belongs to the configured device only
+    mtu_mixspi_nor_op_stats_reset();
+    mtu_mixspi_nor_poll_timing_reset();
     
     //s_userConfig.mixspiBase = FLEXSPI1;
     //s_userConfig.mixspiPort = kFLEXSPI_PortA1;
     memcpy(s_customLUTCommonMode, s_configSystemPacket.memProperty.memLut, CUSTOM_LUT_LENGTH * 4);
     s_userConfig.mixspiCustomLUTVendor = s_customLUTCommonMode;
+    mtu_memory_get_ahb_buf_config(&s_userConfig.ahbBufConfig);
     if (s_configSystemPacket.memProperty.type <= kMemType_FlashMaxIdx)
     {
         s_userConfig.flashBusyStatusOffset = 0;
@@ -158,23 +186,53 @@ status_t mtu_memory_init(void)
 
     printf("FLEXSPI%d module initialized.\r\n", s_userConfig.instance);
 
+    // HyperFlash has CFI instead of SFDP, SFDP LUT is 1-pad SPI based
+    if ((s_configSystemPacket.memProperty.type <= kMemType_OctalSPI) && s_configSystemPacket.memProperty.flashSfdpMode)
+    {
+        status = mtu_flash_sfdp_configure(&s_userConfig, s_customLUTCommonMode);
+        if (status != kStatus_Success)
+        {
+            printf("Flash failed to be configured from SFDP.\r\n");
+            goto flash_error;
+        }
+    }
+
     if (s_configSystemPacket.memProperty.type == kMemType_QuadSPI)
     {
         /* Get JEDEC ID. */
         status = mtu_mixspi_nor_get_jedec_id(&s_userConfig, &jedecID);
         if (status != kStatus_Success)
         {
-            return status;
+            goto flash_error;
+        }
+        const nor_device_family_t *family = mtu_flash_validate_jedec_id((jedec_id_t *)&jedecID);
+        if (family != NULL)
+        {
+            mtu_memory_apply_nor_family(family);
         }
-        mtu_flash_validate_jedec_id((jedec_id_t *)&jedecID);
 
-        status = mtu_mixspi_nor_enable_quad_mode(&s_userConfig);
+        if ((family != NULL) && (family->interface < kNorDeviceIf_QuadSPI))
+        {
+            printf("Flash has no Quad I/O, quad enable is skipped.\r\n");
+        }
+        else
+        {
+            status = mtu_mixspi_nor_enable_quad_mode(&s_userConfig);
+            if (status != kStatus_Success)
+            {
+                printf("Flash failed to enter Quad I/O SDR mode.\r\n");
+                goto flash_error;
+            }
+            printf("Flash entered Quad I/O SDR mode.\r\n");
+        }
+    }
+    if (s_configSystemPacket.memProperty.type <= kMemType_FlashMaxIdx)
+    {
+        status = mtu_memory_set_nor_size();
         if (status != kStatus_Success)
         {
-            printf("Flash failed to enter Quad I/O SDR mode.\r\n");
-            return status;
+            goto flash_error;
         }
-        printf("Flash entered Quad I/O SDR mode.\r\n");
     }
     else if (s_configSystemPacket.memProperty.type > kMemType_FlashMaxIdx)
     {
@@ -189,6 +247,11 @@ status_t mtu_memory_init(void)
     }
     
     return kStatus_Success;
+
+flash_error:
+    // Failed config must not leave device in 4-byte address mode, boot ROM and next config expect reset mode
+    mtu_mixspi_nor_exit_4byte_mode(&s_userConfig);
+    return status;
 }
 
 status_t mtu_memory_get_info(void)
@@ -211,10 +274,126 @@ status_t mtu_memory_get_info(void)
     regAccess.regSeqIdx = NOR_CMD_LUT_SEQ_IDX_READREG2;
     mtu_mixspi_nor_read_register(&s_userConfig, &regAccess);
     printf("Flash Custom Register2: 0x%x\r\n", regAccess.regValue.B.reg1);
+    mtu_mixspi_nor_op_stats_print();
     
     return kStatus_Success;
 }
 
+static void mtu_memory_apply_nor_family(const nor_device_family_t *family)
+{
+    // Host may ask for less than family limit, never for more
+    mixspi_root_clk_freq_t clkFreq = mtu_flash_limit_root_clk(s_userConfig.mixspiRootClkFreq, family->maxClkMHz);
+    if (clkFreq != s_userConfig.mixspiRootClkFreq)
+    {
+        mtu_memory_set_root_clk(clkFreq);
+        printf("FlexSPI root clock lowered to %dMHz for this flash family.\r\n", g_mixspiRootClkFreqInMHz[clkFreq]);
+    }
+
+    // Only default latency is known, host LUT may match a reconfigured device
+    uint8_t readOpcode;
+    uint32_t readCycles = mtu_mixspi_nor_get_read_cycles(s_customLUTCommonMode, &readOpcode);
+    if (family->quadReadCycles && ((readOpcode == 0xEB) || (readOpcode == 0xEC)) &&
+        (readCycles != family->quadReadCycles))
+    {
+        printf("WARNING: Read LUT has %d mode/dummy cycles, flash default is %d.\r\n", readCycles,
+               family->quadReadCycles);
+    }
+    if (!(family->eraseSizes & NOR_DEVICE_ERASE_4KB))
+    {
+        printf("WARNING: Flash family has no 4KB erase, sector erase may fail.\r\n");
+    }
+}
+
+static void mtu_memory_get_ahb_buf_config(mixspi_ahb_buf_config_t *ahbBuf)
+{
+    // Invalid master/alignment bytes keep layout of previous firmware: shared buffers, 1KB alignment
+    uint8_t master = s_configSystemPacket.ahbBufMaster;
+    uint8_t alignment = s_configSystemPacket.ahbBufAlignment;
+    uint16_t bufSize = s_configSystemPacket.prefetchBufSizeInByte & ~7U;
+    memset(ahbBuf, 0, sizeof(*ahbBuf));
+    ahbBuf->enablePrefetch = (s_configSystemPacket.enablePreftech != kAhbPrefetchCtrl_Disable);
+    ahbBuf->alignment = (alignment & AHB_BUF_VALID_MASK) ? (alignment & AHB_BUF_ALIGNMENT_MASK) : 1;
+    ahbBuf->masterId = MIXSPI_AHB_BUF_NO_MASTER;
+    if (bufSize > (FLEXSPI_AHBRXBUFCR0_BUFSZ_MASK >> FLEXSPI_AHBRXBUFCR0_BUFSZ_SHIFT) * 8)
+    {
+        bufSize = (FLEXSPI_AHBRXBUFCR0_BUFSZ_MASK >> FLEXSPI_AHBRXBUFCR0_BUFSZ_SHIFT) * 8;
+    }
+    if (master & AHB_BUF_VALID_MASK)
+    {
+        ahbBuf->masterId = master & AHB_BUF_MASTER_ID_MASK;
+        ahbBuf->masterPriority = (master & AHB_BUF_MASTER_PRIORITY_MASK) >> AHB_BUF_MASTER_PRIORITY_SHIFT;
+        ahbBuf->masterBufSize = bufSize;
+    }
+    else
+    {
+        ahbBuf->sharedBufSize = bufSize;
+    }
+    // Sizes over buffer RAM are cut when the layout is programmed
+}
+
+static void mtu_memory_apply_l1_cache(void)
+{
+    // Core caches are not per region, they serve internal and external memory alike
+    if (s_configSystemPacket.enableL1Cache == kL1CacheCtrl_Enable)
+    {
+        mtu_mixspi_nor_enable_cache(s_memL1CacheStatus);
+        memset(&s_memL1CacheStatus, 0, sizeof(s_memL1CacheStatus));
+        printf("L1 cache is enabled.\r\n");
+    }
+    else if (s_configSystemPacket.enableL1Cache == kL1CacheCtrl_Disable)
+    {
+        mixspi_cache_status_t cacheStatus = {0};
+        mtu_mixspi_nor_disable_cache(&cacheStatus);
+        s_memL1CacheStatus.DCacheEnableFlag |= cacheStatus.DCacheEnableFlag;
+        s_memL1CacheStatus.ICacheEnableFlag |= cacheStatus.ICacheEnableFlag;
+        s_memL1CacheStatus.codeCacheEnableFlag |= cacheStatus.codeCacheEnableFlag;
+        s_memL1CacheStatus.systemCacheEnableFlag |= cacheStatus.systemCacheEnableFlag;
+        s_memL1CacheStatus.CacheEnableFlag |= cacheStatus.CacheEnableFlag;
+        printf("L1 cache is disabled, FW code/data run uncached too.\r\n");
+    }
+}
+
+static status_t mtu_memory_set_nor_size(void)
+{
+    // Default covers 3-byte address space, as the AHB map of fixed device config did
+    uint32_t flashSize = MTU_MEM_NOR_3B_ADDR_MAX_SIZE;
+    if (s_configSystemPacket.memProperty.flashSizeLog2)
+    {
+        flashSize = (s_configSystemPacket.memProperty.flashSizeLog2 < 32) ?
+                        (1UL << s_configSystemPacket.memProperty.flashSizeLog2) : MTU_MEM_MAX_MAP_SIZE;
+    }
+    else if (mtu_flash_get_mem_size() > flashSize)
+    {
+        flashSize = mtu_flash_get_mem_size();
+    }
+    if (flashSize > MTU_MEM_MAX_MAP_SIZE)
+    {
+        flashSize = MTU_MEM_MAX_MAP_SIZE;
+    }
+
+    // HyperFlash LUT address is row/column bits, it is never rewritten
+    if ((flashSize > MTU_MEM_NOR_3B_ADDR_MAX_SIZE) &&
+        (s_configSystemPacket.memProperty.type != kMemType_HyperFlash))
+    {
+        status_t status = mtu_mixspi_nor_enable_4byte_addr(&s_userConfig, s_customLUTCommonMode);
+        if (status != kStatus_Success)
+        {
+            printf("Flash failed to enter 4-byte address mode.\r\n");
+            return status;
+        }
+    }
+
+    if (s_nordeviceconfig.flashSize != flashSize / 0x400)
+    {
+        s_nordeviceconfig.flashSize = flashSize / 0x400;
+        FLEXSPI_SetFlashConfig(s_userConfig.mixspiBase, &s_nordeviceconfig, s_userConfig.mixspiPort);
+        FLEXSPI_SoftwareReset(s_userConfig.mixspiBase);
+    }
+    printf("Flash AHB map size: %dMB.\r\n", flashSize / 0x100000);
+
+    return kStatus_Success;
+}
+
 static void mtu_memory_preset_rw_buffer(uint32_t patternWord)
 {
     for (uint32_t i = 0; i < sizeof(s_memRwBuffer) / sizeof(uint32_t); i++)
@@ -223,7 +402,115 @@ static void mtu_memory_preset_rw_buffer(uint32_t patternWord)
     }
 }
 
-static uint32_t mtu_memory_convert_to_offset_addr(uint32_t memStart)
+static uint32_t mtu_memory_fetch_pattern(void *context, uint32_t maxLen, const uint8_t **data)
+{
+    // Pattern buffer is handed out again for every command, nothing is copied
+    *data = (const uint8_t *)s_memRwBuffer;
+
+    return (maxLen < sizeof(s_memRwBuffer)) ? maxLen : sizeof(s_memRwBuffer);
+}
+
+static status_t mtu_memory_erase_nor(uint32_t offsetAddr, uint32_t size)
+{
+    uint32_t endAddr = offsetAddr + size;
+    for (uint32_t sectorAddr = offsetAddr & ~(MTU_MEM_NOR_SECTOR_SIZE - 1); sectorAddr < endAddr;
+         sectorAddr += MTU_MEM_NOR_SECTOR_SIZE)
+    {
+        status_t status = mtu_mixspi_nor_erase_sector(&s_userConfig, sectorAddr, kFlashInstMode_SPI);
+        if (status != kStatus_Success)
+        {
+            printf("Erase flash sector failure at address 0x%x!\r\n", sectorAddr);
+            return kStatus_Fail;
+        }
+    }
+
+    return kStatus_Success;
+}
+
+static uint32_t mtu_memory_fetch_offset_pattern(void *context, uint32_t maxLen, const uint8_t **data)
+{
+    mem_pattern_source_t *source = (mem_pattern_source_t *)context;
+    uint32_t len = (maxLen < sizeof(s_memPatternBuffer)) ? maxLen : sizeof(s_memPatternBuffer);
+    for (uint32_t i = 0; i < len / 4; i++)
+    {
+        s_memPatternBuffer[i] = mtu_memory_pattern_word(source->offset + i * 4, 0);
+    }
+    source->offset += len;
+    *data = (const uint8_t *)s_memPatternBuffer;
+
+    return len;
+}
+
+uint32_t mtu_memory_pattern_word(uint32_t offset, uint32_t seed)
+{
+    // Neighbour words differ in most bits, so every data line toggles and a shifted read never matches
+    return (~offset ^ (offset << 16)) ^ seed;
+}
+
+status_t mtu_memory_program_nor_pattern(uint32_t offsetAddr, uint32_t size)
+{
+    if (mtu_memory_erase_nor(offsetAddr, size) != kStatus_Success)
+    {
+        return kStatus_Fail;
+    }
+    mem_pattern_source_t source = {0};
+    if (mtu_mixspi_nor_write_stream(&s_userConfig, &s_nordeviceconfig, offsetAddr, size, kFlashInstMode_SPI,
+                                    mtu_memory_fetch_offset_pattern, &source) != kStatus_Success)
+    {
+        printf("Program flash failure at address 0x%x!\r\n", offsetAddr);
+        return kStatus_Fail;
+    }
+    mtu_mixspi_nor_cache_sync();
+
+    return kStatus_Success;
+}
+
+uint32_t mtu_memory_verify_pattern(uint32_t ambaAddr, uint32_t size, uint32_t seed)
+{
+    uint32_t errors = 0;
+    for (uint32_t offset = 0; offset < size; offset += 4)
+    {
+        if (*(volatile uint32_t *)(ambaAddr + offset) != mtu_memory_pattern_word(offset, seed))
+        {
+            errors++;
+        }
+    }
+
+    return errors;
+}
+
+uint32_t mtu_memory_set_root_clk(mixspi_root_clk_freq_t clkFreq)
+{
+    flexspi_device_config_t *deviceconfig = (s_configSystemPacket.memProperty.type <= kMemType_FlashMaxIdx) ?
+                                                &s_nordeviceconfig : &s_ramdeviceconfig;
+    s_userConfig.mixspiRootClkFreq = clkFreq;
+    bsp_mixspi_clock_init(&s_userConfig);
+
+    /* Get current flexspi root clock. */
+    deviceconfig->flexspiRootClk = bsp_mixspi_get_clock(&s_userConfig);
+
+    /* Update DLL value depending on flexspi root clock. */
+    FLEXSPI_UpdateDllValue(s_userConfig.mixspiBase, deviceconfig, s_userConfig.mixspiPort);
+
+    /* Do software reset. */
+    FLEXSPI_SoftwareReset(s_userConfig.mixspiBase);
+
+    return deviceconfig->flexspiRootClk;
+}
+
+void mtu_memory_set_read_sample_clk(mixspi_read_sample_clock_t sampleClk)
+{
+    MIXSPI_Type *base = s_userConfig.mixspiBase;
+    s_userConfig.mixspiReadSampleClock = sampleClk;
+    FLEXSPI_Enable(base, false);
+    base->MCR0 = (base->MCR0 & ~FLEXSPI_MCR0_RXCLKSRC_MASK) | FLEXSPI_MCR0_RXCLKSRC(sampleClk);
+    FLEXSPI_Enable(base, true);
+
+    // DLL mode depends on sample clock source, it is recalculated with current root clock
+    mtu_memory_set_root_clk(s_userConfig.mixspiRootClkFreq);
+}
+
+uint32_t mtu_memory_convert_to_offset_addr(uint32_t memStart)
 {
     uint32_t offsetAddr = memStart;
     uint32_t ambaBase = bsp_mixspi_get_amba_base(&s_userConfig);
@@ -248,30 +535,22 @@ status_t mtu_memory_rwtest(uint8_t memType, uint32_t memStart, uint32_t memSize,
     }
     else
     {
-        uint32_t sectorMax = memSize / 0x1000;
-        uint32_t pagesPerSector = 0x1000 / 0x100;
         uint32_t offsetAddr = mtu_memory_convert_to_offset_addr(memStart);
-        for (uint32_t sectorId = 0; sectorId < sectorMax; sectorId++)
+        if (mtu_memory_erase_nor(offsetAddr, memSize) != kStatus_Success)
         {
-            uint32_t sectorAddr = offsetAddr + sectorId * 0x1000;
-            status_t status = mtu_mixspi_nor_erase_sector(&s_userConfig, sectorAddr, kFlashInstMode_SPI);
-            if (status != kStatus_Success)
-            {
-                printf("Erase flash sector failure at address 0x%x!\r\n", sectorAddr);
-                return kStatus_Fail;
-            }
-            mtu_memory_preset_rw_buffer(memPattern);
-            for (uint32_t pageId = 0; pageId < pagesPerSector; pageId++)
-            {
-                uint32_t pageAddr = sectorAddr + pageId * 0x100;
-                status = mtu_mixspi_nor_page_program(&s_userConfig, &s_nordeviceconfig, pageAddr, (const uint32_t *)s_memRwBuffer, 0x100, kFlashInstMode_SPI);
-                if (status != kStatus_Success)
-                {
-                    printf("Program flash page failure at address 0x%x!\r\n", pageAddr);
-                    return kStatus_Fail;
-                }
-            }
+            return kStatus_Fail;
         }
+        mtu_memory_preset_rw_buffer(memPattern);
+        status_t status = mtu_mixspi_nor_write_stream(&s_userConfig, &s_nordeviceconfig, offsetAddr, memSize,
+                                                      kFlashInstMode_SPI, mtu_memory_fetch_pattern, NULL);
+        if (status != kStatus_Success)
+        {
+            printf("Program flash failure in region [0x%x - 0x%x)!\r\n", offsetAddr, offsetAddr + memSize);
+            return kStatus_Fail;
+        }
+#if defined(MTU_CACHE_MAINTAIN) && MTU_CACHE_MAINTAIN
+        mtu_mixspi_nor_cache_sync();
+#endif
         if (offsetAddr == memStart)
         {
             memStart += bsp_mixspi_get_amba_base(&s_userConfig);
@@ -293,4 +572,37 @@ status_t mtu_memory_rwtest(uint8_t memType, uint32_t memStart, uint32_t memSize,
     return kStatus_Success;
 }
 
+status_t mtu_memory_load(uint8_t memType, uint32_t memStart, const uint8_t *src, uint32_t size, uint32_t *loadAddr)
+{
+    if (memType > kMemType_FlashMaxIdx)
+    {
+        memcpy((void *)memStart, src, size);
+        *loadAddr = memStart;
+        return kStatus_Success;
+    }
+
+    uint32_t offsetAddr = mtu_memory_convert_to_offset_addr(memStart);
+    if (offsetAddr & (MTU_MEM_NOR_SECTOR_SIZE - 1))
+    {
+        printf("Load address 0x%x is not aligned with flash sector!\r\n", memStart);
+        return kStatus_InvalidArgument;
+    }
+    if (mtu_memory_erase_nor(offsetAddr, size) != kStatus_Success)
+    {
+        return kStatus_Fail;
+    }
+    // Image is programmed straight from source, tail of last page is left erased
+    status_t status = mtu_mixspi_nor_write(&s_userConfig, &s_nordeviceconfig, offsetAddr, src, size, kFlashInstMode_SPI);
+    if (status != kStatus_Success)
+    {
+        printf("Program flash failure in region [0x%x - 0x%x)!\r\n", offsetAddr, offsetAddr + size);
+        return kStatus_Fail;
+    }
+#if defined(MTU_CACHE_MAINTAIN) && MTU_CACHE_MAINTAIN
+    // Last sector may be partly programmed, its pending range is not invalidated yet
+    mtu_mixspi_nor_cache_sync();
+#endif
+    *loadAddr = offsetAddr + bsp_mixspi_get_amba_base(&s_userConfig);
 
+    return kStatus_Success;
+}
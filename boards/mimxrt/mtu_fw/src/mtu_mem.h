@@ -10,6 +10,7 @@
 
 #include "mtu_mem_nor_ops.h"
 #include "mtu_mem_nor_device.h"
+#include "mtu_mem_nor_sfdp.h"
 #include "mtu_mem_ram_ops.h"
 #include "mtu_mem_ram_device.h"
 
@@ -19,10 +20,20 @@
 
 #define MTU_MEM_MAX_MAP_SIZE (512 * 1024 * 1024UL)
 
+//! @brief NOR devices above this size need 4-byte address commands.
+#define MTU_MEM_NOR_3B_ADDR_MAX_SIZE (16 * 1024 * 1024UL)
+
+//! @brief NOR erase/program units used by sector erase and page program LUT sequences.
+#define MTU_MEM_NOR_SECTOR_SIZE (0x1000)
+#define MTU_MEM_NOR_PAGE_SIZE   (0x100)
+
 /*******************************************************************************
  * Variables
  ******************************************************************************/
 
+extern flexspi_device_config_t s_nordeviceconfig;
+
+extern uint32_t s_customLUTCommonMode[];
 
 /*******************************************************************************
  * API
@@ -34,4 +45,18 @@ status_t mtu_memory_get_info(void);
 
 status_t mtu_memory_rwtest(uint8_t memType, uint32_t memStart, uint32_t memSize, uint32_t memPattern);
 
+uint32_t mtu_memory_convert_to_offset_addr(uint32_t memStart);
+
+uint32_t mtu_memory_set_root_clk(mixspi_root_clk_freq_t clkFreq);
+
+void mtu_memory_set_read_sample_clk(mixspi_read_sample_clock_t sampleClk);
+
+status_t mtu_memory_load(uint8_t memType, uint32_t memStart, const uint8_t *src, uint32_t size, uint32_t *loadAddr);
+
+uint32_t mtu_memory_pattern_word(uint32_t offset, uint32_t seed);
+
+status_t mtu_memory_program_nor_pattern(uint32_t offsetAddr, uint32_t size);
+
+uint32_t mtu_memory_verify_pattern(uint32_t ambaAddr, uint32_t size, uint32_t seed);
+
 #endif /* _MTU_MEM_H_ */
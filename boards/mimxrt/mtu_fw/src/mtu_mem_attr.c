@@ -0,0 +1,154 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "mtu.h"
+#include "fsl_cache.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+static void mtu_mem_attr_write_seq(uint32_t ambaAddr, uint32_t size, uint32_t seed);
+
+static void mtu_mem_attr_measure(uint32_t ambaAddr, uint32_t size, uint32_t rounds, bool isWritable,
+                                 mem_attr_result_t *result);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+//! @brief Attributes in report order, from the one frame buffers usually get.
+static const struct
+{
+    const char *name;
+    bsp_mem_attr_t attr;
+} s_memAttrs[] = {
+    {"write back", kBspMemAttr_WriteBack},
+    {"write through", kBspMemAttr_WriteThrough},
+    {"non-cacheable", kBspMemAttr_NonCacheable},
+    {"device", kBspMemAttr_Device},
+};
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static void mtu_mem_attr_write_seq(uint32_t ambaAddr, uint32_t size, uint32_t seed)
+{
+    for (uint32_t offset = 0; offset < size; offset += 4)
+    {
+        *(volatile uint32_t *)(ambaAddr + offset) = seed ^ offset;
+    }
+}
+
+static void mtu_mem_attr_measure(uint32_t ambaAddr, uint32_t size, uint32_t rounds, bool isWritable,
+                                 mem_attr_result_t *result)
+{
+    // Every timed read starts from an empty cache, so cacheable attributes are compared on memory fetches
+    for (uint32_t round = 0; round < rounds; round++)
+    {
+        uint32_t cycles;
+        if (isWritable)
+        {
+            cycles = mtu_cycle_timer_count();
+            mtu_mem_attr_write_seq(ambaAddr, size, round);
+#if defined(MTU_CACHE_MAINTAIN) && MTU_CACHE_MAINTAIN
+            // Frame is complete once it reaches memory, as display DMA reads it from there
+            DCACHE_CleanByRange(ambaAddr, size);
+#endif
+            result->writeCycles += mtu_cycle_timer_count() - cycles;
+        }
+
+#if defined(MTU_CACHE_MAINTAIN) && MTU_CACHE_MAINTAIN
+        // Write pass left the tail of the region in cache
+        DCACHE_CleanInvalidateByRange(ambaAddr, size);
+#endif
+        cycles = mtu_cycle_timer_count();
+        mtu_perf_read_seq(ambaAddr, size);
+        result->readCycles += mtu_cycle_timer_count() - cycles;
+        result->bytes += size;
+
+#if defined(MTU_CACHE_MAINTAIN) && MTU_CACHE_MAINTAIN
+        DCACHE_CleanInvalidateByRange(ambaAddr, size);
+#endif
+        cycles = mtu_cycle_timer_count();
+        mtu_perf_read_random(ambaAddr, size, MTU_MEM_ATTR_LATENCY_READS);
+        result->randomCycles += mtu_cycle_timer_count() - cycles;
+        result->randomReads += MTU_MEM_ATTR_LATENCY_READS;
+    }
+}
+
+status_t mtu_mem_attr_run(uint32_t rounds, uint32_t memStart, uint32_t memSize)
+{
+    printf("Arg List: rounds=%d, memStart=0x%x, memSize=0x%x.\n", rounds, memStart, memSize);
+
+    if (s_configSystemPacket.memProperty.type == kMemType_InternalSRAM)
+    {
+        printf("MPU attribute benchmark only runs on external memory.\r\n");
+        return kStatus_InvalidArgument;
+    }
+    if (memSize < 4)
+    {
+        printf("Test memory region is too small.\r\n");
+        return kStatus_InvalidArgument;
+    }
+    if (!rounds)
+    {
+        rounds = 1;
+    }
+    uint32_t size = ((memSize > MTU_MEM_ATTR_MAX_SIZE) ? MTU_MEM_ATTR_MAX_SIZE : memSize) & ~3UL;
+    uint32_t ambaAddr = mtu_memory_convert_to_offset_addr(memStart) + bsp_mixspi_get_amba_base(&s_userConfig);
+    // NOR Flash is read only through AHB, its content is measured as it is
+    bool isWritable = (s_configSystemPacket.memProperty.type > kMemType_FlashMaxIdx);
+
+    mtu_perf_timebase_start();
+    float cyclesPerUs = (float)mtu_cycle_timer_clocks_per_sec() / 1000000;
+    printf("%-14s %10s %10s %14s\r\n", "Attribute", "Write MB/s", "Read MB/s", "Random ns");
+    for (uint32_t idx = 0; idx < ARRAY_SIZE(s_memAttrs); idx++)
+    {
+        status_t status = bsp_rt_system_set_mem_attr(ambaAddr, size, s_memAttrs[idx].attr);
+        if (status != kStatus_Success)
+        {
+            bsp_rt_system_restore_mem_attr();
+            mtu_perf_timebase_stop();
+            printf("MPU attribute '%s' failed to be set.\r\n", s_memAttrs[idx].name);
+            printf("Done and Failed!\r\n");
+            return status;
+        }
+
+        mem_attr_result_t result = {0};
+        mtu_mem_attr_measure(ambaAddr, size, rounds, isWritable, &result);
+        if (isWritable)
+        {
+            printf("%-14s %10.2f", s_memAttrs[idx].name,
+                   (float)result.bytes / ((float)result.writeCycles / cyclesPerUs));
+        }
+        else
+        {
+            printf("%-14s %10s", s_memAttrs[idx].name, "-");
+        }
+        printf(" %10.2f %14.1f\r\n", (float)result.bytes / ((float)result.readCycles / cyclesPerUs),
+               (float)result.randomCycles * 1000 / cyclesPerUs / result.randomReads);
+    }
+    mtu_perf_timebase_stop();
+    bsp_rt_system_restore_mem_attr();
+
+    if (s_configSystemPacket.enableL1Cache == kL1CacheCtrl_Disable)
+    {
+        printf("L1 cache is disabled in config packet, cacheable attributes run uncached.\r\n");
+    }
+    printf("0x%x bytes per pass, %d random reads, %d passes per attribute, first pass is cold.\r\n", size,
+           MTU_MEM_ATTR_LATENCY_READS, rounds);
+
+    printf("Done and Passed!\r\n");
+    return kStatus_Success;
+}
@@ -0,0 +1,39 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _MTU_MEM_ATTR_H_
+#define _MTU_MEM_ATTR_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "fsl_common.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+//! @brief Region written/streamed for bandwidth and hit by random reads for latency, larger than L1 cache.
+#define MTU_MEM_ATTR_MAX_SIZE      (0x20000)
+#define MTU_MEM_ATTR_LATENCY_READS (1024)
+
+//! @brief Result of one MPU attribute, over all rounds.
+typedef struct _mem_attr_result
+{
+    uint64_t writeCycles;   // 0 for NOR Flash, it is not written
+    uint64_t readCycles;
+    uint64_t randomCycles;
+    uint32_t bytes;
+    uint32_t randomReads;
+} mem_attr_result_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+status_t mtu_mem_attr_run(uint32_t rounds, uint32_t memStart, uint32_t memSize);
+
+#endif /* _MTU_MEM_ATTR_H_ */
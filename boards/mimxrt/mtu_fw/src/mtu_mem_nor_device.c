@@ -13,6 +13,19 @@
  * Definitions
  ******************************************************************************/
 
+//! @brief Erase size sets shared by most families.
+#define NOR_DEVICE_ERASE_4K_32K_64K  (NOR_DEVICE_ERASE_4KB | NOR_DEVICE_ERASE_32KB | NOR_DEVICE_ERASE_64KB)
+#define NOR_DEVICE_ERASE_4K_64K      (NOR_DEVICE_ERASE_4KB | NOR_DEVICE_ERASE_64KB)
+#define NOR_DEVICE_ERASE_4K_256K     (NOR_DEVICE_ERASE_4KB | NOR_DEVICE_ERASE_256KB)
+#define NOR_DEVICE_ERASE_4K_32K_128K (NOR_DEVICE_ERASE_4KB | NOR_DEVICE_ERASE_32KB | NOR_DEVICE_ERASE_128KB)
+
+//! @brief Vendor of a manufacturer ID, aliases point to the main vendor ID of family records.
+typedef struct _nor_device_vendor
+{
+    uint8_t manufacturerID;
+    uint8_t familyManufacturerID;
+    const char *name;
+} nor_device_vendor_t;
 
 /*******************************************************************************
  * Prototypes
@@ -21,13 +34,7 @@
 uint32_t mtu_flash_decode_common_capacity_id(uint8_t capacityID);
 uint32_t mtu_flash_decode_adesto_capacity_id(uint8_t capacityID);
 void mtu_flash_show_mem_size(uint8_t capacityID, bool isAdesto);
-void mtu_flash_set_info_for_winbond(jedec_id_t *jedecID);
-void mtu_flash_set_info_for_mxic(jedec_id_t *jedecID);
-void mtu_flash_set_info_for_gigadevice(jedec_id_t *jedecID);
-void mtu_flash_set_info_for_issi(jedec_id_t *jedecID);
-void mtu_flash_set_info_for_micron(jedec_id_t *jedecID);
-void mtu_flash_set_info_for_adesto(jedec_id_t *jedecID);
-void mtu_flash_set_info_for_spansion(jedec_id_t *jedecID);
+static const nor_device_family_t *mtu_flash_find_family(uint8_t manufacturerID, uint8_t memoryTypeID);
 
 /*******************************************************************************
  * Variables
@@ -35,6 +42,79 @@ void mtu_flash_set_info_for_spansion(jedec_id_t *jedecID);
 
 const uint32_t g_mixspiRootClkFreqInMHz[] = {0, 30, 50, 60, 80, 100, 120, 133, 166, 200, 240, 266, 332, 400};
 
+//! @brief Device size decoded from last JEDEC ID, 0 if unknown.
+static uint32_t s_flashMemSizeInBytes;
+
+static const nor_device_vendor_t s_flashVendors[] = {
+    {SPANSION_DEVICE_VENDOR_ID, SPANSION_DEVICE_VENDOR_ID, "Spansion"},
+    {RENESAS_DEVICE_VENDOR_ID, ADESTO_DEVICE_VENDOR_ID, "Adesto"},
+    {MICRON_DEVICE_VENDOR_ID, MICRON_DEVICE_VENDOR_ID, "Micron"},
+    {MICRON_DEVICE_VENDOR_ID2, MICRON_DEVICE_VENDOR_ID, "Micron"},
+    {INFINEON_DEVICE_VENDOR_ID, SPANSION_DEVICE_VENDOR_ID, "Spansion"},
+    {ADESTO_DEVICE_VENDOR_ID, ADESTO_DEVICE_VENDOR_ID, "Adesto"},
+    {ISSI_DEVICE_VENDOR_ID, ISSI_DEVICE_VENDOR_ID, "ISSI"},
+    {MXIC_DEVICE_VENDOR_ID, MXIC_DEVICE_VENDOR_ID, "MXIC"},
+    {GIGADEVICE_DEVICE_VENDOR_ID, GIGADEVICE_DEVICE_VENDOR_ID, "GigaDevice"},
+    {WINBOND_DEVICE_VENDOR_ID, WINBOND_DEVICE_VENDOR_ID, "Winbond"},
+};
+
+//! @brief Device families, sorted by manufacturer ID then memory type ID for binary search.
+static const nor_device_family_t s_flashFamilies[] = {
+    {0x01, 0x2A, kNorDeviceIf_QuadSPI,  kNorDeviceVoltage_3V3,  166, 0,  NOR_DEVICE_ERASE_4K_256K,     "S25HL-T"},
+    {0x01, 0x2B, kNorDeviceIf_QuadSPI,  kNorDeviceVoltage_1V8,  166, 0,  NOR_DEVICE_ERASE_4K_256K,     "S25HS-T"},
+    {0x01, 0x5A, kNorDeviceIf_OctalSPI, kNorDeviceVoltage_3V3,  166, 0,  NOR_DEVICE_ERASE_4K_256K,     "S28HL"},
+    {0x01, 0x5B, kNorDeviceIf_OctalSPI, kNorDeviceVoltage_1V8,  166, 0,  NOR_DEVICE_ERASE_4K_256K,     "S28HS"},
+    {0x01, 0x60, kNorDeviceIf_QuadSPI,  kNorDeviceVoltage_3V3,  108, 6,  NOR_DEVICE_ERASE_4K_32K_64K,  "S25FL-L"},
+    {0x20, 0x5A, kNorDeviceIf_OctalSPI, kNorDeviceVoltage_3V3,  133, 0,  NOR_DEVICE_ERASE_4K_32K_128K, "MT35XL"},
+    {0x20, 0x5B, kNorDeviceIf_OctalSPI, kNorDeviceVoltage_1V8,  166, 0,  NOR_DEVICE_ERASE_4K_32K_128K, "MT35XU"},
+    {0x20, 0xBA, kNorDeviceIf_QuadSPI,  kNorDeviceVoltage_3V3,  133, 10, NOR_DEVICE_ERASE_4K_32K_64K,  "MT25QL"},
+    {0x20, 0xBB, kNorDeviceIf_QuadSPI,  kNorDeviceVoltage_1V8,  133, 10, NOR_DEVICE_ERASE_4K_32K_64K,  "MT25QU"},
+    {0x43, 0x00, kNorDeviceIf_QuadSPI,  kNorDeviceVoltage_Wide, 80,  0,  NOR_DEVICE_ERASE_4K_32K_64K,  "AT25EU"},
+    {0x43, 0x01, kNorDeviceIf_QuadSPI,  kNorDeviceVoltage_2V5,  100, 0,  NOR_DEVICE_ERASE_4K_32K_64K,  "AT25DQ"},
+    {0x43, 0x02, kNorDeviceIf_QuadSPI,  kNorDeviceVoltage_Wide, 104, 0,  NOR_DEVICE_ERASE_4K_32K_64K,  "AT25FF/AT25XE/AT25XV"},
+    {0x43, 0x04, kNorDeviceIf_QuadSPI,  kNorDeviceVoltage_3V3,  104, 0,  NOR_DEVICE_ERASE_4K_32K_64K,  "AT25SF/AT25QF"},
+    {0x43, 0x05, kNorDeviceIf_OctalSPI, kNorDeviceVoltage_1V8,  133, 0,  NOR_DEVICE_ERASE_4K_32K_64K,  "ATXP"},
+    {0x43, 0x42, kNorDeviceIf_QuadSPI,  kNorDeviceVoltage_1V8,  133, 6,  NOR_DEVICE_ERASE_4K_32K_64K,  "AT25SL/AT25QL"},
+    {0x9D, 0x40, kNorDeviceIf_QuadSPI,  kNorDeviceVoltage_3V3,  104, 6,  NOR_DEVICE_ERASE_4K_32K_64K,  "IS25LQ/IS25LP"},
+    {0x9D, 0x5A, kNorDeviceIf_OctalSPI, kNorDeviceVoltage_3V3,  133, 0,  NOR_DEVICE_ERASE_4K_32K_128K, "IS25LX"},
+    {0x9D, 0x5B, kNorDeviceIf_OctalSPI, kNorDeviceVoltage_1V8,  166, 0,  NOR_DEVICE_ERASE_4K_32K_128K, "IS25WX"},
+    {0x9D, 0x60, kNorDeviceIf_QuadSPI,  kNorDeviceVoltage_3V3,  133, 6,  NOR_DEVICE_ERASE_4K_32K_64K,  "IS25LP/IS25LE"},
+    {0x9D, 0x70, kNorDeviceIf_QuadSPI,  kNorDeviceVoltage_1V8,  133, 6,  NOR_DEVICE_ERASE_4K_32K_64K,  "IS25WP/IS25WJ/IS25WE"},
+    {0xC2, 0x20, kNorDeviceIf_QuadSPI,  kNorDeviceVoltage_3V3,  133, 6,  NOR_DEVICE_ERASE_4K_32K_64K,  "MX25L/MX66L"},
+    {0xC2, 0x23, kNorDeviceIf_QuadSPI,  kNorDeviceVoltage_3V3,  104, 6,  NOR_DEVICE_ERASE_4K_32K_64K,  "MX25V"},
+    {0xC2, 0x25, kNorDeviceIf_QuadSPI,  kNorDeviceVoltage_1V8,  133, 6,  NOR_DEVICE_ERASE_4K_32K_64K,  "MX25U/MX66U"},
+    // Ultra low power mode after reset
+    {0xC2, 0x28, kNorDeviceIf_QuadSPI,  kNorDeviceVoltage_Wide, 33,  6,  NOR_DEVICE_ERASE_4K_32K_64K,  "MX25R"},
+    {0xC2, 0x75, kNorDeviceIf_QuadSPI,  kNorDeviceVoltage_3V3,  133, 6,  NOR_DEVICE_ERASE_4K_32K_64K,  "MX77L"},
+    {0xC2, 0x80, kNorDeviceIf_OctalSPI, kNorDeviceVoltage_1V8,  133, 0,  NOR_DEVICE_ERASE_4K_64K,      "MX25UM/MX66UM"},
+    {0xC2, 0x81, kNorDeviceIf_OctalSPI, kNorDeviceVoltage_1V8,  133, 0,  NOR_DEVICE_ERASE_4K_64K,      "MX25UM51345G"},
+    {0xC2, 0x83, kNorDeviceIf_OctalSPI, kNorDeviceVoltage_1V8,  133, 0,  NOR_DEVICE_ERASE_4K_64K,      "MX25UM25345G"},
+    {0xC2, 0x84, kNorDeviceIf_OctalSPI, kNorDeviceVoltage_1V8,  133, 0,  NOR_DEVICE_ERASE_4K_64K,      "MX25UWxx345G"},
+    {0xC2, 0x85, kNorDeviceIf_OctalSPI, kNorDeviceVoltage_3V3,  133, 0,  NOR_DEVICE_ERASE_4K_64K,      "MX25LM/MX66LM"},
+    {0xC8, 0x40, kNorDeviceIf_QuadSPI,  kNorDeviceVoltage_3V3,  133, 6,  NOR_DEVICE_ERASE_4K_32K_64K,  "GD25Q/GD25B/GD25S"},
+    {0xC8, 0x42, kNorDeviceIf_QuadSPI,  kNorDeviceVoltage_2V5,  104, 6,  NOR_DEVICE_ERASE_4K_32K_64K,  "GD25VQ/GD25VE"},
+    {0xC8, 0x47, kNorDeviceIf_QuadSPI,  kNorDeviceVoltage_3V3,  133, 6,  NOR_DEVICE_ERASE_4K_32K_64K,  "GD55B"},
+    {0xC8, 0x48, kNorDeviceIf_OctalSPI, kNorDeviceVoltage_3V3,  166, 0,  NOR_DEVICE_ERASE_4K_64K,      "GD25X/GD55X"},
+    {0xC8, 0x60, kNorDeviceIf_QuadSPI,  kNorDeviceVoltage_1V8,  133, 6,  NOR_DEVICE_ERASE_4K_32K_64K,  "GD25LE/GD25LQ"},
+    {0xC8, 0x63, kNorDeviceIf_QuadSPI,  kNorDeviceVoltage_1V8,  133, 0,  NOR_DEVICE_ERASE_4K_32K_64K,  "GD25LF/GD55LF"},
+    {0xC8, 0x65, kNorDeviceIf_QuadSPI,  kNorDeviceVoltage_Wide, 104, 6,  NOR_DEVICE_ERASE_4K_32K_64K,  "GD25W/GD55W"},
+    {0xC8, 0x66, kNorDeviceIf_QuadSPI,  kNorDeviceVoltage_1V8,  133, 0,  NOR_DEVICE_ERASE_4K_32K_64K,  "GD25LT/GD55LT"},
+    {0xC8, 0x67, kNorDeviceIf_QuadSPI,  kNorDeviceVoltage_1V8,  133, 6,  NOR_DEVICE_ERASE_4K_32K_64K,  "GD25LB/GD55LB"},
+    {0xC8, 0x68, kNorDeviceIf_OctalSPI, kNorDeviceVoltage_1V8,  166, 0,  NOR_DEVICE_ERASE_4K_64K,      "GD25LX/GD55LX"},
+    {0xEF, 0x30, kNorDeviceIf_DualSPI,  kNorDeviceVoltage_3V3,  104, 0,  NOR_DEVICE_ERASE_4K_32K_64K,  "W25X"},
+    {0xEF, 0x40, kNorDeviceIf_QuadSPI,  kNorDeviceVoltage_3V3,  133, 6,  NOR_DEVICE_ERASE_4K_32K_64K,  "W25QxxxDV/FV/BV/CL/JV(-IQ/JQ)"},
+    {0xEF, 0x5B, kNorDeviceIf_OctalSPI, kNorDeviceVoltage_1V8,  166, 0,  NOR_DEVICE_ERASE_4K_64K,      "W35TxxxNW"},
+    {0xEF, 0x60, kNorDeviceIf_QuadSPI,  kNorDeviceVoltage_1V8,  133, 6,  NOR_DEVICE_ERASE_4K_32K_64K,  "W25QxxxJW/FW/EW/NW(-IQ/IN)"},
+    {0xEF, 0x61, kNorDeviceIf_QuadSPI,  kNorDeviceVoltage_1V8,  133, 6,  NOR_DEVICE_ERASE_4K_32K_64K,  "W25MxxxJW"},
+    {0xEF, 0x65, kNorDeviceIf_QuadSPI,  kNorDeviceVoltage_1V2,  104, 6,  NOR_DEVICE_ERASE_4K_32K_64K,  "W25QxxxNE"},
+    {0xEF, 0x70, kNorDeviceIf_QuadSPI,  kNorDeviceVoltage_3V3,  133, 6,  NOR_DEVICE_ERASE_4K_32K_64K,  "W25QxxxJV(-IM/JM)"},
+    {0xEF, 0x80, kNorDeviceIf_QuadSPI,  kNorDeviceVoltage_1V8,  133, 6,  NOR_DEVICE_ERASE_4K_32K_64K,  "W25QxxxJW/NW(-IM)"},
+};
+
+static const char *const s_flashInterfaceName[kNorDeviceIf_MaxIdx] = {"DualSPI", "QuadSPI", "OctalSPI"};
+
+static const char *const s_flashVoltageName[kNorDeviceVoltage_MaxIdx] = {"1.2V", "1.8V", "2.5V", "3.3V", "1.8-3.3V"};
+
 /*******************************************************************************
  * Code
  ******************************************************************************/
@@ -145,13 +225,14 @@ void mtu_flash_show_mem_size(uint8_t capacityID, bool isAdesto)
     if (isAdesto)
     {
         printf("Flash Density Code: 0x%x", capacityID);
-        flashMemSizeInKB = mtu_flash_decode_adesto_capacity_id(capacityID)/ 0x400;
+        s_flashMemSizeInBytes = mtu_flash_decode_adesto_capacity_id(capacityID);
     }
     else
     {
         printf("Flash Capacity ID: 0x%x", capacityID);
-        flashMemSizeInKB = mtu_flash_decode_common_capacity_id(capacityID)/ 0x400;
+        s_flashMemSizeInBytes = mtu_flash_decode_common_capacity_id(capacityID);
     }
+    flashMemSizeInKB = s_flashMemSizeInBytes / 0x400;
     if (flashMemSizeInKB <= 0x400)
     {
         printf(" -- %dKB.\r\n", flashMemSizeInKB);
@@ -162,206 +243,58 @@ void mtu_flash_show_mem_size(uint8_t capacityID, bool isAdesto)
     }
 }
 
-void mtu_flash_set_info_for_winbond(jedec_id_t *jedecID)
+static const nor_device_family_t *mtu_flash_find_family(uint8_t manufacturerID, uint8_t memoryTypeID)
 {
-    printf("Flash Manufacturer ID: 0x%x -- Winbond Serial Flash.\r\n", jedecID->manufacturerID);
-    printf("Flash Memory Type ID: 0x%x", jedecID->memoryTypeID);
-    switch (jedecID->memoryTypeID)
+    uint32_t key = ((uint32_t)manufacturerID << 8) | memoryTypeID;
+    uint32_t low = 0;
+    uint32_t high = ARRAY_SIZE(s_flashFamilies);
+    while (low < high)
     {
-        /////////////////////////QuadSPI////////////////////////
-        case 0x30:
-            printf(" -- W25X DualSPI 3.3V Series.\r\n");
-            break;
-        case 0x40:
-            printf(" -- W25QxxxDV/FV/BV/CL/JV(-IQ/JQ) QuadlSPI 3.3V Series.\r\n");
-            break;
-        case 0x60:
-            printf(" -- W25QxxxJW/FW/EW/NW(-IQ/IN) QuadlSPI 1.8V Series.\r\n");
-            break;
-        case 0x61:
-            printf(" -- W25MxxxJW QuadlSPI 1.8V Series.\r\n");
-            break;
-        case 0x65:
-            printf(" -- W25QxxxNE QuadlSPI 1.2V Series.\r\n");
-            break;
-        case 0x70:
-            printf(" -- W25QxxxJV(-IM/JM) QuadlSPI 3.3V Series.\r\n");
-            break;
-        case 0x80:
-            printf(" -- W25QxxxJW/NW(-IM) QuadlSPI 1.8V Series.\r\n");
-            break;
-        ////////////////////////OctalSPI////////////////////////
-        case 0x5B:
-            printf(" -- W35TxxxNW OctalSPI 1.8V Series.\r\n");
-            break;
-        // Missing W25H, W25R
-        // Missing xxxJL, xxxDW, xxxRV
-        default:
-            printf(" -- Unknown Series.\r\n");
-            break;
+        uint32_t mid = (low + high) / 2;
+        uint32_t midKey = ((uint32_t)s_flashFamilies[mid].manufacturerID << 8) | s_flashFamilies[mid].memoryTypeID;
+        if (midKey == key)
+        {
+            return &s_flashFamilies[mid];
+        }
+        else if (midKey < key)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
     }
-    mtu_flash_show_mem_size(jedecID->capacityID, false);
-}
 
-void mtu_flash_set_info_for_mxic(jedec_id_t *jedecID)
-{
-    printf("Flash Manufacturer ID: 0x%x -- MXIC Serial Flash.\r\n", jedecID->manufacturerID);
-    printf("Flash Memory Type ID: 0x%x", jedecID->memoryTypeID);
-    switch (jedecID->memoryTypeID)
-    {
-        /////////////////////////QuadSPI////////////////////////
-        case 0x20:
-            printf(" -- MX25L/MX66L QuadSPI 3.3V Series.\r\n");
-            break;
-        case 0x23:
-            printf(" -- MX25V QuadSPI 3.3V Series.\r\n");
-            break;
-        case 0x25:
-            printf(" -- MX25U/MX66U QuadSPI 1.8V Series.\r\n");
-            break;
-        case 0x28:
-            printf(" -- MX25R QuadSPI 1.8-3.3V Series.\r\n");
-            break;
-        case 0x75:
-            printf(" -- MX77L QuadSPI 3.3V Series.\r\n");
-            break;
-        ////////////////////////OctalSPI////////////////////////
-        case 0x80:
-            printf(" -- MX25UM/MX66UM OctalSPI 1.8V Series.\r\n");
-            break;
-        case 0x81:
-            printf(" -- MX25UM51345G OctalSPI 1.8V Series.\r\n");
-            break;
-        case 0x83:
-            printf(" -- MX25UM25345G OctalSPI 1.8V Series.\r\n");
-            break;
-        case 0x84:
-            printf(" -- MX25UWxx345G OctalSPI 1.8V Series.\r\n");
-            break;
-        case 0x85:
-            printf(" -- MX25LM/MX66LM OctalSPI 3.3V Series.\r\n");
-            break;
-        // Missing MX25LW51245G, MX66LW1G45G, MX66LW2G45G
-        // Missing MX25UW6445G, MX66UW12845G, MX25UW25645G, MX25UW51245G, MX66UW1G45G, MX66UW2G45G
-        // Missing MX25UW6345G, MX66LW12345G, MX66UW25345G      done                 , MX66UW2G345G
-        default:
-            printf(" -- Unknown Series.\r\n");
-            break;
-    }
-    mtu_flash_show_mem_size(jedecID->capacityID, false);
+    return NULL;
 }
 
-void mtu_flash_set_info_for_gigadevice(jedec_id_t *jedecID)
+const nor_device_family_t *mtu_flash_validate_jedec_id(jedec_id_t *jedecID)
 {
-    printf("Flash Manufacturer ID: 0x%x -- GigaDevice Serial Flash.\r\n", jedecID->manufacturerID);
-    printf("Flash Memory Type ID: 0x%x", jedecID->memoryTypeID);
-    switch (jedecID->memoryTypeID)
-    {
-        /////////////////////////QuadSPI////////////////////////
-        case 0x40:
-            // GD25D DualSPI
-            printf(" -- GD25Q/GD25B/GD25S QuadSPI 3.3V Series.\r\n");
-            break;
-        case 0x42:
-            printf(" -- GD25VQ/GD25VE QuadSPI 2.5V Series.\r\n");
-            break;
-        case 0x47:
-            printf(" -- GD55B QuadSPI 3.3V Series.\r\n");
-            break;
-        case 0x60:
-            // GD25LD DualSPI
-            printf(" -- GD25LE/GD25LQ QuadSPI 1.8V Series.\r\n");
-            break;
-        case 0x63:
-            printf(" -- GD25LF/GD55LF QuadSPI 1.8V Series.\r\n");
-            break;
-        case 0x65:
-            // GD25WD DualSPI
-            printf(" -- GD25W/GD55W QuadSPI 1.8-3.3V Series.\r\n");
-            break;
-        case 0x66:
-            printf(" -- GD25LT/GD55LT QuadSPI 1.8V Series.\r\n");
-            break;
-        case 0x67:
-            printf(" -- GD25LB/GD55LB QuadSPI 1.8V Series.\r\n");
-            break;
-        ////////////////////////OctalSPI////////////////////////
-        case 0x48:
-            printf(" -- GD25X/GD55X OctalSPI 3.3V Series.\r\n");
-            break;
-        case 0x68:
-            printf(" -- GD25LX/GD55LX OctalSPI 1.8V Series.\r\n");
-            break;
-        // Missing GD25F, GD25LR, GD25T, GD25R
-        default:
-            printf(" -- Unknown Series.\r\n");
-            break;
-    }
-    mtu_flash_show_mem_size(jedecID->capacityID, false);
-}
+    const nor_device_vendor_t *vendor = NULL;
+    s_flashMemSizeInBytes = 0;
 
-void mtu_flash_set_info_for_issi(jedec_id_t *jedecID)
-{
-    printf("Flash Manufacturer ID: 0x%x -- ISSI Serial Flash.\r\n", jedecID->manufacturerID);
-    printf("Flash Memory Type ID: 0x%x", jedecID->memoryTypeID);
-    switch (jedecID->memoryTypeID)
+    /* Check Vendor ID. */
+    for (uint32_t i = 0; i < ARRAY_SIZE(s_flashVendors); i++)
     {
-        /////////////////////////QuadSPI////////////////////////
-        case 0x40:
-            printf(" -- IS25LQ/IS25LP QuadSPI 3.3V Series.\r\n");
-            break;
-        case 0x60:
-            printf(" -- IS25LP/IS25LE QuadSPI 3.3V Series.\r\n");
-            break;
-        case 0x70:
-            printf(" -- IS25WP/IS25WJ/IS25WE QuadSPI 1.8V Series.\r\n");
-            break;
-        ////////////////////////OctalSPI////////////////////////
-        case 0x5A:
-            printf(" -- IS25LX OctalSPI 3.3V Series.\r\n");
-            break;
-        case 0x5B:
-            printf(" -- IS25WX OctalSPI 1.8V Series.\r\n");
-            break;
-        default:
-            printf(" -- Unknown Series.\r\n");
+        if (s_flashVendors[i].manufacturerID == jedecID->manufacturerID)
+        {
+            vendor = &s_flashVendors[i];
             break;
+        }
     }
-    mtu_flash_show_mem_size(jedecID->capacityID, false);
-}
-
-void mtu_flash_set_info_for_micron(jedec_id_t *jedecID)
-{
-    printf("Flash Manufacturer ID: 0x%x -- Micron Serial Flash.\r\n", jedecID->manufacturerID);
-    printf("Flash Memory Type ID: 0x%x", jedecID->memoryTypeID);
-    switch (jedecID->memoryTypeID)
+    if (vendor == NULL)
     {
-        /////////////////////////QuadSPI////////////////////////
-        case 0xBA:
-            printf(" -- MT25QL QuadSPI 3.3V Series.\r\n");
-            break;
-        case 0xBB:
-            printf(" -- MT25QU QuadSPI 1.8V Series.\r\n");
-            break;
-        ////////////////////////OctalSPI////////////////////////
-        case 0x5A:
-            printf(" -- MT35XL OctalSPI 3.3V Series.\r\n");
-            break;
-        case 0x5B:
-            printf(" -- MT35XU OctalSPI 1.8V Series.\r\n");
-            break;
-        default:
-            printf(" -- Unknown Series.\r\n");
-            break;
+        printf("Unknown Manufacturer ID\r\n");
+        return NULL;
     }
-    mtu_flash_show_mem_size(jedecID->capacityID, false);
-}
+    printf("Flash Manufacturer ID: 0x%x -- %s Serial Flash.\r\n", jedecID->manufacturerID, vendor->name);
 
-void mtu_flash_set_info_for_adesto(jedec_id_t *jedecID)
-{
-    printf("Flash Manufacturer ID: 0x%x -- Adesto Serial Flash.\r\n", jedecID->manufacturerID);
-    if (jedecID->memoryTypeID != 0x42)
+    bool isAdestoDensity = false;
+    if ((vendor->familyManufacturerID == ADESTO_DEVICE_VENDOR_ID) &&
+        (jedecID->memoryTypeID != ADESTO_COMMON_MEMORY_TYPE_ID))
     {
+        isAdestoDensity = true;
         jedecID->capacityID = jedecID->memoryTypeID & 0x1F;
         jedecID->memoryTypeID = (jedecID->memoryTypeID & 0xE0) >> 5;
         printf("Flash Family Code: 0x%x", jedecID->memoryTypeID);
@@ -370,112 +303,39 @@ void mtu_flash_set_info_for_adesto(jedec_id_t *jedecID)
     {
         printf("Flash Memory Type ID: 0x%x", jedecID->memoryTypeID);
     }
-    switch (jedecID->memoryTypeID)
+
+    const nor_device_family_t *family = mtu_flash_find_family(vendor->familyManufacturerID, jedecID->memoryTypeID);
+    if (family != NULL)
     {
-        /////////////////////////QuadSPI////////////////////////
-        case 0x00:
-            printf(" -- AT25EU QuadSPI 1.8-3.3V Series.\r\n");
-            break;
-        case 0x01:
-            printf(" -- AT25DQ QuadSPI 2.5V Series.\r\n");
-            break;
-        case 0x02:
-            printf(" -- AT25FF/AT25XE/AT25XV QuadSPI 1.8-3.3V Series.\r\n");
-            break;
-        case 0x04:
-            printf(" -- AT25SF/AT25QF QuadSPI 3.3V Series.\r\n");
-            break;
-        // Only this type is same as other vendors
-        case 0x42:
-            printf(" -- AT25SL/AT25QL QuadSPI 1.8V Series.\r\n");
-            break;
-        ////////////////////////OctalSPI////////////////////////
-        case 0x05:
-            printf(" -- ATXP OctalSPI 1.8V Series.\r\n");
-            break;
-        default:
-            printf(" -- Unknown Series.\r\n");
-            break;
+        printf(" -- %s %s %s Series, up to %dMHz.\r\n", family->name, s_flashInterfaceName[family->interface],
+               s_flashVoltageName[family->voltage], family->maxClkMHz);
     }
-    mtu_flash_show_mem_size(jedecID->capacityID, (jedecID->memoryTypeID != 0x42));
-}
-
-void mtu_flash_set_info_for_spansion(jedec_id_t *jedecID)
-{
-    printf("Flash Manufacturer ID: 0x%x -- Spansion Serial Flash.\r\n", jedecID->manufacturerID);
-    printf("Flash Memory Type ID: 0x%x", jedecID->memoryTypeID);
-    switch (jedecID->memoryTypeID)
+    else
     {
-        /////////////////////////QuadSPI////////////////////////
-        case 0x2A:
-            printf(" -- S25HL-T QuadSPI 3.3V Series.\r\n");
-            break;
-        case 0x2B:
-            printf(" -- S25HS-T QuadSPI 1.8V Series.\r\n");
-            break;
-        case 0x60:
-            // S25FL-L QuadSPI
-            printf(" -- S25FL-L QuadSPI 3.3V Series.\r\n");
-            break;
-        ////////////////////////OctalSPI////////////////////////
-        case 0x5A:
-            printf(" -- S28HL OctalSPI 3.3V Series.\r\n");
-            break;
-        case 0x5B:
-            printf(" -- S28HS OctalSPI 1.8V Series.\r\n");
-            break;
-        default:
-            printf(" -- Unknown Series.\r\n");
-            break;
+        printf(" -- Unknown Series.\r\n");
     }
-    mtu_flash_show_mem_size(jedecID->capacityID, false);
+    mtu_flash_show_mem_size(jedecID->capacityID, isAdestoDensity);
+
+    return family;
 }
 
-void mtu_flash_validate_jedec_id(jedec_id_t *jedecID)
+mixspi_root_clk_freq_t mtu_flash_limit_root_clk(mixspi_root_clk_freq_t clkFreq, uint32_t maxClkInMHz)
 {
-    /* Check Vendor ID. */
-    switch (jedecID->manufacturerID)
+    uint32_t idx = clkFreq;
+    while ((idx > kMixspiRootClkFreq_30MHz) && (g_mixspiRootClkFreqInMHz[idx] > maxClkInMHz))
     {
-        // Winbond
-        case WINBOND_DEVICE_VENDOR_ID:
-            mtu_flash_set_info_for_winbond(jedecID);
-            break;
-
-        // MXIC
-        case MXIC_DEVICE_VENDOR_ID:
-            mtu_flash_set_info_for_mxic(jedecID);
-            break;
-
-        // GigaDevice
-        case GIGADEVICE_DEVICE_VENDOR_ID:
-            mtu_flash_set_info_for_gigadevice(jedecID);
-            break;
-
-        // ISSI
-        case ISSI_DEVICE_VENDOR_ID:
-            mtu_flash_set_info_for_issi(jedecID);
-            break;
-
-        // Micron
-        case MICRON_DEVICE_VENDOR_ID:
-        case MICRON_DEVICE_VENDOR_ID2:
-            mtu_flash_set_info_for_micron(jedecID);
-            break;
+        idx--;
+    }
 
-        // Adesto
-        case ADESTO_DEVICE_VENDOR_ID:
-        case RENESAS_DEVICE_VENDOR_ID:
-            mtu_flash_set_info_for_adesto(jedecID);
-            break;
+    return (mixspi_root_clk_freq_t)idx;
+}
 
-        // Spansion
-        case SPANSION_DEVICE_VENDOR_ID:
-        case INFINEON_DEVICE_VENDOR_ID:
-            mtu_flash_set_info_for_spansion(jedecID);
-            break;
+uint32_t mtu_flash_get_mem_size(void)
+{
+    return s_flashMemSizeInBytes;
+}
 
-        default:
-            printf("Unknown Manufacturer ID\r\n");
-            break;
-    }
+void mtu_flash_clear_mem_size(void)
+{
+    s_flashMemSizeInBytes = 0;
 }
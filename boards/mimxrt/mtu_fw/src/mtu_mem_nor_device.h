@@ -34,12 +34,66 @@ typedef struct _jedec_id
 #define SPANSION_DEVICE_VENDOR_ID   (0x01)
 #define INFINEON_DEVICE_VENDOR_ID   (0x34)
 
+//! @brief Adesto memory type ID is family code and density code, except this one.
+#define ADESTO_COMMON_MEMORY_TYPE_ID (0x42)
+
+//! @brief Interfaces of a device family, each one includes the slower ones.
+enum _nor_device_interfaces
+{
+    kNorDeviceIf_DualSPI  = 0x00,
+    kNorDeviceIf_QuadSPI  = 0x01,
+    kNorDeviceIf_OctalSPI = 0x02,
+    kNorDeviceIf_MaxIdx,
+};
+
+enum _nor_device_voltages
+{
+    kNorDeviceVoltage_1V2  = 0x00,
+    kNorDeviceVoltage_1V8  = 0x01,
+    kNorDeviceVoltage_2V5  = 0x02,
+    kNorDeviceVoltage_3V3  = 0x03,
+    kNorDeviceVoltage_Wide = 0x04,    // 1.8-3.3V
+    kNorDeviceVoltage_MaxIdx,
+};
+
+//! @brief Erase sizes of a device family, as bit mask.
+#define NOR_DEVICE_ERASE_4KB   (0x01)
+#define NOR_DEVICE_ERASE_32KB  (0x02)
+#define NOR_DEVICE_ERASE_64KB  (0x04)
+#define NOR_DEVICE_ERASE_128KB (0x08)
+#define NOR_DEVICE_ERASE_256KB (0x10)
+
+//! @brief One device family, records are sorted by manufacturer ID then memory type ID.
+typedef struct _nor_device_family
+{
+    uint8_t manufacturerID;    // Vendor aliases use the main vendor ID
+    uint8_t memoryTypeID;      // Adesto: family code, except ADESTO_COMMON_MEMORY_TYPE_ID
+    uint8_t interface;
+    uint8_t voltage;
+    uint16_t maxClkMHz;        // SDR clock supported in default device configuration
+    uint8_t quadReadCycles;    // Mode + dummy cycles of EBh in default configuration, 0: unknown or no quad
+    uint8_t eraseSizes;
+    const char *name;
+} nor_device_family_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+extern const uint32_t g_mixspiRootClkFreqInMHz[];
+
 /*******************************************************************************
  * API
  ******************************************************************************/
 
-void mtu_flash_validate_jedec_id(jedec_id_t *jedecID);
+const nor_device_family_t *mtu_flash_validate_jedec_id(jedec_id_t *jedecID);
 
 mixspi_root_clk_freq_t mtu_flash_convert_root_clk(uint32_t clkInMHz);
 
+mixspi_root_clk_freq_t mtu_flash_limit_root_clk(mixspi_root_clk_freq_t clkFreq, uint32_t maxClkInMHz);
+
+uint32_t mtu_flash_get_mem_size(void);
+
+void mtu_flash_clear_mem_size(void);
+
 #endif /* _MTU_MEM_NOR_DEVICE_H_ */
@@ -8,12 +8,12 @@
  */
 
 #include "mtu_mem_nor_ops.h"
+#include "fsl_cache.h"
 
 /*******************************************************************************
  * Definitions
  ******************************************************************************/
 
-
 /*******************************************************************************
  * Prototypes
  ******************************************************************************/
@@ -23,6 +23,62 @@
  * Variables
  *****************************************************************************/
 
+static nor_op_stat_t s_norOpStat[kNorOp_MaxIdx];
+
+//! @brief Compile-time polling timing, SFDP of a device overrides it until next config.
+static const nor_poll_timing_t s_norPollTimingDefault[kNorOp_MaxIdx] = {
+    {NOR_ERASE_SECTOR_TYPICAL_US, NOR_ERASE_SECTOR_TIMEOUT_US, NOR_ERASE_SECTOR_MIN_INTERVAL_US},
+    {NOR_PAGE_PROGRAM_TYPICAL_US, NOR_PAGE_PROGRAM_TIMEOUT_US, NOR_PAGE_PROGRAM_MIN_INTERVAL_US},
+    {NOR_WRITE_REGISTER_TYPICAL_US, NOR_WRITE_REGISTER_TIMEOUT_US, NOR_WRITE_REGISTER_MIN_INTERVAL_US},
+    {NOR_SUSPEND_TYPICAL_US, NOR_SUSPEND_TIMEOUT_US, NOR_SUSPEND_MIN_INTERVAL_US},
+};
+
+static nor_poll_timing_t s_norPollTiming[kNorOp_MaxIdx];
+
+static bool s_isNorPollPrecise;
+
+//! @brief Wait before the last poll of latest busy wait, it bounds the error of measured busy time.
+static uint32_t s_norPollResolutionUs;
+
+//! @brief 3-byte address commands and their dedicated 4-byte address counterparts.
+static const uint8_t s_nor4ByteOpcodes[][2] = {
+    {0x03, 0x13},    // Read
+    {0x0B, 0x0C},    // Fast read
+    {0x3B, 0x3C},    // Dual output fast read
+    {0xBB, 0xBC},    // Dual I/O fast read
+    {0x6B, 0x6C},    // Quad output fast read
+    {0xEB, 0xEC},    // Quad I/O fast read
+    {0x0D, 0x0E},    // DTR fast read
+    {0xED, 0xEE},    // DTR quad I/O fast read
+    {0x02, 0x12},    // Page program
+    {0x32, 0x34},    // Quad input page program
+    {0x38, 0x3E},    // Quad I/O page program
+    {0x20, 0x21},    // 4KB sector erase
+    {0x52, 0x5C},    // 32KB block erase
+    {0xD8, 0xDC},    // 64KB block erase
+};
+
+static const char *const s_norOpName[kNorOp_MaxIdx] = {"Sector erase", "Page program", "Write register", "Suspend"};
+
+//! @brief Erase/program suspend and resume opcodes, SFDP of a device may replace them.
+static uint8_t s_norSuspendOpcode = NOR_SUSPEND_OPCODE;
+static uint8_t s_norResumeOpcode = NOR_RESUME_OPCODE;
+
+static uint8_t s_norAhbSyncPolicy = kNorAhbSync_ClearBuffer;
+
+static nor_hyper_session_t s_norHyperSession;
+
+//! @brief Device was put into 4-byte address mode, it keeps it until exit command or power cycle.
+static bool s_isNor4ByteMode;
+
+//! @brief Word aligned copy of misaligned write source, one command at most.
+static uint32_t s_norWriteAlignBuffer[NOR_HYPER_WRITE_BUFFER_SIZE / 4];
+
+#if defined(MTU_CACHE_MAINTAIN_BY_RANGE) && MTU_CACHE_MAINTAIN_BY_RANGE
+//! @brief AMBA range changed by erase/program but not invalidated yet, it never spans two sectors.
+static uint32_t s_norCacheRangeStart;
+static uint32_t s_norCacheRangeEnd;
+#endif
 
 /*******************************************************************************
  * Code
@@ -62,6 +118,20 @@ void mtu_mixspi_nor_disable_cache(mixspi_cache_status_t *cacheStatus)
         cacheStatus->systemCacheEnableFlag = true;
     }
 
+#elif (defined FSL_FEATURE_SOC_XCACHE_COUNT) && (FSL_FEATURE_SOC_XCACHE_COUNT != 0U)
+    /* Disable code bus cache and system bus cache, dirty lines of system cache go out first */
+    if (XCACHE_CCR_ENCACHE_MASK == (XCACHE_CCR_ENCACHE_MASK & XCACHE_PC->CCR))
+    {
+        XCACHE_DisableCache(XCACHE_PC);
+        cacheStatus->codeCacheEnableFlag = true;
+    }
+    if (XCACHE_CCR_ENCACHE_MASK == (XCACHE_CCR_ENCACHE_MASK & XCACHE_PS->CCR))
+    {
+        XCACHE_CleanCache(XCACHE_PS);
+        XCACHE_DisableCache(XCACHE_PS);
+        cacheStatus->systemCacheEnableFlag = true;
+    }
+
 #elif (defined FSL_FEATURE_SOC_CACHE64_CTRL_COUNT) && (FSL_FEATURE_SOC_CACHE64_CTRL_COUNT != 0U)
     /* Disable cache */
     CACHE64_DisableCache(EXAMPLE_CACHE);
@@ -100,6 +170,18 @@ void mtu_mixspi_nor_enable_cache(mixspi_cache_status_t cacheStatus)
         /* Enable system cache. */
         L1CACHE_EnableSystemCache();
     }
+#elif (defined FSL_FEATURE_SOC_XCACHE_COUNT) && (FSL_FEATURE_SOC_XCACHE_COUNT != 0U)
+    if (cacheStatus.codeCacheEnableFlag)
+    {
+        /* Enable code cache. */
+        XCACHE_EnableCache(XCACHE_PC);
+    }
+
+    if (cacheStatus.systemCacheEnableFlag)
+    {
+        /* Enable system cache. */
+        XCACHE_EnableCache(XCACHE_PS);
+    }
 #elif (defined FSL_FEATURE_SOC_CACHE64_CTRL_COUNT) && (FSL_FEATURE_SOC_CACHE64_CTRL_COUNT != 0U)
     if (cacheStatus.CacheEnableFlag)
     {
@@ -109,6 +191,123 @@ void mtu_mixspi_nor_enable_cache(mixspi_cache_status_t cacheStatus)
 #endif
 }
 
+void mtu_mixspi_nor_invalidate_cache_range(uint32_t ambaAddr, uint32_t size)
+{
+#if (defined __CORTEX_M) && (__CORTEX_M == 7U)
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+    if (SCB_CCR_DC_Msk == (SCB_CCR_DC_Msk & SCB->CCR))
+    {
+        DCACHE_InvalidateByRange(ambaAddr, size);
+    }
+#endif /* __DCACHE_PRESENT */
+
+#if defined(__ICACHE_PRESENT) && (__ICACHE_PRESENT == 1U)
+    if (SCB_CCR_IC_Msk == (SCB_CCR_IC_Msk & SCB->CCR))
+    {
+        ICACHE_InvalidateByRange(ambaAddr, size);
+    }
+#endif /* __ICACHE_PRESENT */
+
+#elif (defined FSL_FEATURE_SOC_LMEM_COUNT) && (FSL_FEATURE_SOC_LMEM_COUNT != 0U)
+    if (LMEM_PCCCR_ENCACHE_MASK == (LMEM_PCCCR_ENCACHE_MASK & LMEM->PCCCR))
+    {
+        L1CACHE_InvalidateCodeCacheByRange(ambaAddr, size);
+    }
+    if (LMEM_PSCCR_ENCACHE_MASK == (LMEM_PSCCR_ENCACHE_MASK & LMEM->PSCCR))
+    {
+        L1CACHE_InvalidateSystemCacheByRange(ambaAddr, size);
+    }
+
+#elif (defined FSL_FEATURE_SOC_XCACHE_COUNT) && (FSL_FEATURE_SOC_XCACHE_COUNT != 0U)
+    /* Cache instance is looked up by address */
+    XCACHE_InvalidateCacheByRange(ambaAddr, size);
+
+#elif (defined FSL_FEATURE_SOC_CACHE64_CTRL_COUNT) && (FSL_FEATURE_SOC_CACHE64_CTRL_COUNT != 0U)
+    /* Cache instance is looked up by address */
+    CACHE64_InvalidateCacheByRange(ambaAddr, size);
+#endif
+}
+
+void mtu_mixspi_nor_cache_sync(void)
+{
+#if defined(MTU_CACHE_MAINTAIN_BY_RANGE) && MTU_CACHE_MAINTAIN_BY_RANGE
+    if (s_norCacheRangeEnd != s_norCacheRangeStart)
+    {
+        mtu_mixspi_nor_invalidate_cache_range(s_norCacheRangeStart, s_norCacheRangeEnd - s_norCacheRangeStart);
+        s_norCacheRangeStart = 0;
+        s_norCacheRangeEnd = 0;
+    }
+#endif
+}
+
+#if defined(MTU_CACHE_MAINTAIN_BY_RANGE) && MTU_CACHE_MAINTAIN_BY_RANGE
+static void mtu_mixspi_nor_cache_range_add(mixspi_user_config_t *userConfig, uint32_t address, uint32_t size)
+{
+    uint32_t start = address + bsp_mixspi_get_amba_base(userConfig);
+    uint32_t end = start + size;
+
+    /* Pending range is invalidated once per sector, when next operation goes to another sector */
+    if ((s_norCacheRangeEnd != s_norCacheRangeStart) &&
+        ((start & ~(MTU_MEM_NOR_SECTOR_SIZE - 1)) != (s_norCacheRangeStart & ~(MTU_MEM_NOR_SECTOR_SIZE - 1))))
+    {
+        mtu_mixspi_nor_cache_sync();
+    }
+    if (s_norCacheRangeEnd == s_norCacheRangeStart)
+    {
+        s_norCacheRangeStart = start;
+        s_norCacheRangeEnd = end;
+    }
+    else
+    {
+        s_norCacheRangeStart = (start < s_norCacheRangeStart) ? start : s_norCacheRangeStart;
+        s_norCacheRangeEnd = (end > s_norCacheRangeEnd) ? end : s_norCacheRangeEnd;
+    }
+
+    /* or when the operation reaches the end of sector (erase, or program of its last page) */
+    if (!(end & (MTU_MEM_NOR_SECTOR_SIZE - 1)))
+    {
+        mtu_mixspi_nor_cache_sync();
+    }
+}
+#endif
+
+static void mtu_mixspi_nor_ahb_sync(mixspi_user_config_t *userConfig, status_t status, bool isArrayChanged)
+{
+    /* Software reset recovers controller from a failed command */
+    if ((status != kStatus_Success) || (s_norAhbSyncPolicy == kNorAhbSync_Reset))
+    {
+        FLEXSPI_SoftwareReset(userConfig->mixspiBase);
+        return;
+    }
+
+    /* Register/ID reads leave array as it was, prefetched AHB data is still valid */
+    if (!isArrayChanged)
+    {
+        return;
+    }
+
+    /* Clear AHB buffer directly, or do software reset. */
+#if defined(FLEXSPI_AHBCR_CLRAHBRXBUF_MASK) && defined(FLEXSPI_AHBCR_CLRAHBTXBUF_MASK)
+    userConfig->mixspiBase->AHBCR |= FLEXSPI_AHBCR_CLRAHBRXBUF_MASK | FLEXSPI_AHBCR_CLRAHBTXBUF_MASK;
+    userConfig->mixspiBase->AHBCR &= ~(FLEXSPI_AHBCR_CLRAHBRXBUF_MASK | FLEXSPI_AHBCR_CLRAHBTXBUF_MASK);
+#else
+    FLEXSPI_SoftwareReset(userConfig->mixspiBase);
+#endif
+}
+
+void mtu_mixspi_nor_set_ahb_sync_policy(uint8_t policy)
+{
+    if (policy < kNorAhbSync_MaxIdx)
+    {
+        s_norAhbSyncPolicy = policy;
+    }
+}
+
+uint8_t mtu_mixspi_nor_get_ahb_sync_policy(void)
+{
+    return s_norAhbSyncPolicy;
+}
+
 static status_t mtu_mixspi_nor_write_enable(mixspi_user_config_t *userConfig, uint32_t baseAddr, flash_inst_mode_t flashInstMode)
 {
     flexspi_transfer_t flashXfer;
@@ -149,10 +348,8 @@ static status_t mtu_mixspi_nor_write_enable(mixspi_user_config_t *userConfig, ui
     return status;
 }
 
-static status_t mtu_mixspi_nor_wait_bus_busy(mixspi_user_config_t *userConfig, flash_inst_mode_t flashInstMode)
+status_t mtu_mixspi_nor_read_busy(mixspi_user_config_t *userConfig, flash_inst_mode_t flashInstMode, bool *isBusy)
 {
-    /* Wait status ready. */
-    bool isBusy;
     uint32_t readValue;
     status_t status;
     flexspi_transfer_t flashXfer;
@@ -189,61 +386,142 @@ static status_t mtu_mixspi_nor_wait_bus_busy(mixspi_user_config_t *userConfig, f
     }
     flashXfer.data     = &readValue;
 
-    do
+    status = FLEXSPI_TransferBlocking(userConfig->mixspiBase, &flashXfer);
+    if (status != kStatus_Success)
     {
-        status = FLEXSPI_TransferBlocking(userConfig->mixspiBase, &flashXfer);
-
-        if (status != kStatus_Success)
+        return status;
+    }
+    if (flashInstMode == kFlashInstMode_Hyper)
+    {
+        if (readValue & (1U << (userConfig->flashBusyStatusOffset + 8)))
         {
-            return status;
+            *isBusy = false;
+        }
+        else
+        {
+            *isBusy = true;
+        }
+        if (readValue & ((uint16_t)userConfig->flashMixStatusMask << 8))
+        {
+            status = kStatus_Fail;
         }
-        if (flashInstMode == kFlashInstMode_Hyper)
+    }
+    else
+    {
+        if (userConfig->flashBusyStatusPol)
         {
-            if (readValue & (1U << (userConfig->flashBusyStatusOffset + 8)))
+            if (readValue & (1U << userConfig->flashBusyStatusOffset))
             {
-                isBusy = false;
+                *isBusy = true;
             }
             else
             {
-                isBusy = true;
-            }
-            if (readValue & ((uint16_t)userConfig->flashMixStatusMask << 8))
-            {
-                status = kStatus_Fail;
-                break;
+                *isBusy = false;
             }
         }
         else
         {
-            if (userConfig->flashBusyStatusPol)
+            if (readValue & (1U << userConfig->flashBusyStatusOffset))
             {
-                if (readValue & (1U << userConfig->flashBusyStatusOffset))
-                {
-                    isBusy = true;
-                }
-                else
-                {
-                    isBusy = false;
-                }
+                *isBusy = false;
             }
             else
             {
-                if (readValue & (1U << userConfig->flashBusyStatusOffset))
-                {
-                    isBusy = false;
-                }
-                else
-                {
-                    isBusy = true;
-                }
+                *isBusy = true;
             }
         }
+        if ((!*isBusy) && (readValue & userConfig->flashErrorStatusMask))
+        {
+            status = kStatus_Fail;
+        }
+    }
+
+    return status;
+}
+
+static status_t mtu_mixspi_nor_wait_bus_busy(mixspi_user_config_t *userConfig, flash_inst_mode_t flashInstMode, uint8_t op, uint32_t *pollCount)
+{
+    /* Wait status ready. */
+    bool isBusy;
+    status_t status;
+
+    *pollCount = 0;
+
+    const nor_poll_timing_t *timing = &s_norPollTiming[op];
+    uint32_t maxIntervalUs = timing->typicalUs / 4;
+    if (maxIntervalUs > NOR_POLL_MAX_INTERVAL_US)
+    {
+        maxIntervalUs = NOR_POLL_MAX_INTERVAL_US;
+    }
+    if ((maxIntervalUs < timing->minIntervalUs) || s_isNorPollPrecise)
+    {
+        maxIntervalUs = timing->minIntervalUs;
+    }
+    uint32_t intervalUs = timing->minIntervalUs;
+    uint64_t timeoutCycles = (uint64_t)timing->timeoutUs * (mtu_cycle_timer_clocks_per_sec() / 1000000);
+    uint64_t elapsedCycles = 0;
+    uint32_t lastCycles = mtu_cycle_timer_count();
+
+    /* Device cannot be ready long before typical time, keep IP bus free meanwhile. */
+    s_norPollResolutionUs = 0;
+    if (!s_isNorPollPrecise)
+    {
+        s_norPollResolutionUs = (uint32_t)((uint64_t)timing->typicalUs * NOR_POLL_INITIAL_DELAY_PERCENT / 100);
+        bsp_mixspi_sw_delay_us(s_norPollResolutionUs);
+    }
+    do
+    {
+        status = mtu_mixspi_nor_read_busy(userConfig, flashInstMode, &isBusy);
+        (*pollCount)++;
+
+        if (status != kStatus_Success)
+        {
+            return status;
+        }
 
+        if (isBusy)
+        {
+            uint32_t nowCycles = mtu_cycle_timer_count();
+            elapsedCycles += nowCycles - lastCycles;
+            lastCycles = nowCycles;
+            if (elapsedCycles > timeoutCycles)
+            {
+                printf("Flash is still busy after %d us (%d polls)!\r\n", timing->timeoutUs, *pollCount);
+                status = kStatus_Timeout;
+                break;
+            }
+            bsp_mixspi_sw_delay_us(intervalUs);
+            s_norPollResolutionUs = intervalUs;
+            intervalUs = (intervalUs * 2 > maxIntervalUs) ? maxIntervalUs : (intervalUs * 2);
+        }
     } while (isBusy);
 
     return status;
 }
 
+static void mtu_mixspi_nor_op_record(uint8_t op, uint32_t cmdCycles, uint32_t busyCycles, uint32_t polls)
+{
+    nor_op_stat_t *stat = &s_norOpStat[op];
+    stat->count++;
+    stat->polls += polls;
+    stat->cmdCycles += cmdCycles;
+    stat->busyCycles += busyCycles;
+    if (polls > stat->maxPolls)
+    {
+        stat->maxPolls = polls;
+    }
+    if (busyCycles > stat->maxBusyCycles)
+    {
+        stat->maxBusyCycles = busyCycles;
+    }
+    if (s_norPollResolutionUs > stat->maxResolutionUs)
+    {
+        stat->maxResolutionUs = s_norPollResolutionUs;
+    }
+    stat->cmdHist[cmdCycles ? (31 - __CLZ(cmdCycles)) : 0]++;
+    stat->busyHist[busyCycles ? (31 - __CLZ(busyCycles)) : 0]++;
+}
+
 status_t mtu_mixspi_nor_write_register(mixspi_user_config_t *userConfig, flash_reg_access_t *regAccess)
 {
     flexspi_transfer_t flashXfer;
@@ -254,19 +532,25 @@ status_t mtu_mixspi_nor_write_register(mixspi_user_config_t *userConfig, flash_r
         return kStatus_Success;
     }
 
-#if defined(MTU_CACHE_MAINTAIN) && MTU_CACHE_MAINTAIN
-    mixspi_cache_status_t cacheStatus;
+#if defined(MTU_CACHE_MAINTAIN) && MTU_CACHE_MAINTAIN && \
+    !(defined(MTU_CACHE_MAINTAIN_BY_RANGE) && MTU_CACHE_MAINTAIN_BY_RANGE)
+    mixspi_cache_status_t cacheStatus = {0};
     mtu_mixspi_nor_disable_cache(&cacheStatus);
 #endif
 
     uint32_t writeValue = regAccess->regValue.U;
+    uint32_t polls;
+    uint32_t busyCycles;
+
+    mtu_cycle_timer_ensure_running();
+    uint32_t cmdCycles = mtu_cycle_timer_count();
 
     /* Write enable */
     status = mtu_mixspi_nor_write_enable(userConfig, 0, kFlashInstMode_SPI);
 
     if (status != kStatus_Success)
     {
-        return status;
+        goto cleanup;
     }
 
     flashXfer.deviceAddress = 0;
@@ -280,16 +564,21 @@ status_t mtu_mixspi_nor_write_register(mixspi_user_config_t *userConfig, flash_r
     status = FLEXSPI_TransferBlocking(userConfig->mixspiBase, &flashXfer);
     if (status != kStatus_Success)
     {
-        return status;
+        goto cleanup;
     }
 
-    status = mtu_mixspi_nor_wait_bus_busy(userConfig, kFlashInstMode_SPI);
-    bsp_mixspi_sw_delay_us(100000UL);
+    busyCycles = mtu_cycle_timer_count();
+    cmdCycles = busyCycles - cmdCycles;
+    status = mtu_mixspi_nor_wait_bus_busy(userConfig, kFlashInstMode_SPI, kNorOp_WriteRegister, &polls);
+    busyCycles = mtu_cycle_timer_count() - busyCycles;
+    mtu_mixspi_nor_op_record(kNorOp_WriteRegister, cmdCycles, busyCycles, polls);
 
-    /* Do software reset. */
-    FLEXSPI_SoftwareReset(userConfig->mixspiBase);
+cleanup:
+    /* Register may change read mode of array, a failed command leaves controller to be reset */
+    mtu_mixspi_nor_ahb_sync(userConfig, status, true);
 
-#if defined(MTU_CACHE_MAINTAIN) && MTU_CACHE_MAINTAIN
+#if defined(MTU_CACHE_MAINTAIN) && MTU_CACHE_MAINTAIN && \
+    !(defined(MTU_CACHE_MAINTAIN_BY_RANGE) && MTU_CACHE_MAINTAIN_BY_RANGE)
     mtu_mixspi_nor_enable_cache(cacheStatus);
 #endif
 
@@ -310,14 +599,7 @@ status_t mtu_mixspi_nor_read_register(mixspi_user_config_t *userConfig, flash_re
 
     status_t status = FLEXSPI_TransferBlocking(userConfig->mixspiBase, &flashXfer);
 
-    /* Do software reset or clear AHB buffer directly. */
-#if defined(FSL_FEATURE_SOC_OTFAD_COUNT) && defined(FLEXSPI_AHBCR_CLRAHBRXBUF_MASK) && \
-    defined(FLEXSPI_AHBCR_CLRAHBTXBUF_MASK)
-    userConfig->mixspiBase->AHBCR |= FLEXSPI_AHBCR_CLRAHBRXBUF_MASK | FLEXSPI_AHBCR_CLRAHBTXBUF_MASK;
-    userConfig->mixspiBase->AHBCR &= ~(FLEXSPI_AHBCR_CLRAHBRXBUF_MASK | FLEXSPI_AHBCR_CLRAHBTXBUF_MASK);
-#else
-    FLEXSPI_SoftwareReset(userConfig->mixspiBase);
-#endif
+    mtu_mixspi_nor_ahb_sync(userConfig, status, false);
     
     regAccess->regValue.U = regVal;
 
@@ -353,28 +635,16 @@ status_t mtu_mixspi_nor_get_jedec_id(mixspi_user_config_t *userConfig, uint32_t
 
     status_t status = FLEXSPI_TransferBlocking(userConfig->mixspiBase, &flashXfer);
 
-    /* Do software reset or clear AHB buffer directly. */
-#if defined(FSL_FEATURE_SOC_OTFAD_COUNT) && defined(FLEXSPI_AHBCR_CLRAHBRXBUF_MASK) && \
-    defined(FLEXSPI_AHBCR_CLRAHBTXBUF_MASK)
-    userConfig->mixspiBase->AHBCR |= FLEXSPI_AHBCR_CLRAHBRXBUF_MASK | FLEXSPI_AHBCR_CLRAHBTXBUF_MASK;
-    userConfig->mixspiBase->AHBCR &= ~(FLEXSPI_AHBCR_CLRAHBRXBUF_MASK | FLEXSPI_AHBCR_CLRAHBTXBUF_MASK);
-#else
-    FLEXSPI_SoftwareReset(userConfig->mixspiBase);
-#endif
+    mtu_mixspi_nor_ahb_sync(userConfig, status, false);
 
     return status;
 }
 
-status_t mtu_mixspi_nor_erase_sector(mixspi_user_config_t *userConfig, uint32_t address, flash_inst_mode_t flashInstMode)
+static status_t mtu_mixspi_nor_erase_sector_command(mixspi_user_config_t *userConfig, uint32_t address, flash_inst_mode_t flashInstMode)
 {
     status_t status;
     flexspi_transfer_t flashXfer;
 
-#if defined(MTU_CACHE_MAINTAIN) && MTU_CACHE_MAINTAIN
-    mixspi_cache_status_t cacheStatus;
-    mtu_mixspi_nor_disable_cache(&cacheStatus);
-#endif
-
     /* Write enable */
     status = mtu_mixspi_nor_write_enable(userConfig, address, kFlashInstMode_SPI);
 
@@ -412,24 +682,215 @@ status_t mtu_mixspi_nor_erase_sector(mixspi_user_config_t *userConfig, uint32_t
             break;
     }
 
-    status = FLEXSPI_TransferBlocking(userConfig->mixspiBase, &flashXfer);
+    return FLEXSPI_TransferBlocking(userConfig->mixspiBase, &flashXfer);
+}
+
+status_t mtu_mixspi_nor_erase_sector(mixspi_user_config_t *userConfig, uint32_t address, flash_inst_mode_t flashInstMode)
+{
+    status_t status;
+
+#if defined(MTU_CACHE_MAINTAIN) && MTU_CACHE_MAINTAIN && \
+    !(defined(MTU_CACHE_MAINTAIN_BY_RANGE) && MTU_CACHE_MAINTAIN_BY_RANGE)
+    mixspi_cache_status_t cacheStatus = {0};
+    mtu_mixspi_nor_disable_cache(&cacheStatus);
+#endif
+
+    uint32_t polls;
+    uint32_t busyCycles;
+    mtu_cycle_timer_ensure_running();
+    uint32_t cmdCycles = mtu_cycle_timer_count();
+
+    status = mtu_mixspi_nor_erase_sector_command(userConfig, address, flashInstMode);
     if (status != kStatus_Success)
     {
-        return status;
+        goto cleanup;
     }
 
-    status = mtu_mixspi_nor_wait_bus_busy(userConfig, flashInstMode);
+    busyCycles = mtu_cycle_timer_count();
+    cmdCycles = busyCycles - cmdCycles;
+    status = mtu_mixspi_nor_wait_bus_busy(userConfig, flashInstMode, kNorOp_EraseSector, &polls);
+    busyCycles = mtu_cycle_timer_count() - busyCycles;
+    mtu_mixspi_nor_op_record(kNorOp_EraseSector, cmdCycles, busyCycles, polls);
 
-    /* Do software reset. */
-    FLEXSPI_SoftwareReset(userConfig->mixspiBase);
+cleanup:
+    /* Sector may be partly erased even if command failed */
+    mtu_mixspi_nor_ahb_sync(userConfig, status, true);
 
 #if defined(MTU_CACHE_MAINTAIN) && MTU_CACHE_MAINTAIN
+#if defined(MTU_CACHE_MAINTAIN_BY_RANGE) && MTU_CACHE_MAINTAIN_BY_RANGE
+    mtu_mixspi_nor_cache_range_add(userConfig, address & ~(MTU_MEM_NOR_SECTOR_SIZE - 1), MTU_MEM_NOR_SECTOR_SIZE);
+#else
     mtu_mixspi_nor_enable_cache(cacheStatus);
 #endif
+#endif
+
+    return status;
+}
+
+status_t mtu_mixspi_nor_erase_sector_start(mixspi_user_config_t *userConfig, uint32_t address, flash_inst_mode_t flashInstMode)
+{
+    mtu_cycle_timer_ensure_running();
+
+    return mtu_mixspi_nor_erase_sector_command(userConfig, address, flashInstMode);
+}
+
+status_t mtu_mixspi_nor_wait_ready(mixspi_user_config_t *userConfig, flash_inst_mode_t flashInstMode, uint8_t op, uint32_t *pollCount)
+{
+    status_t status = mtu_mixspi_nor_wait_bus_busy(userConfig, flashInstMode, op, pollCount);
+
+    /* AHB buffer may hold data read while device was busy. */
+    mtu_mixspi_nor_ahb_sync(userConfig, status, true);
+
+    return status;
+}
+
+static status_t mtu_mixspi_nor_scratch_transfer(mixspi_user_config_t *userConfig,
+                                                const uint32_t *lut,
+                                                flexspi_transfer_t *flashXfer)
+{
+    /* Borrow scratch LUT slot, then give host LUT content back. */
+    FLEXSPI_UpdateLUT(userConfig->mixspiBase, 4 * NOR_CMD_LUT_SEQ_IDX_SCRATCH, lut, 4);
+
+    flashXfer->port      = userConfig->mixspiPort;
+    flashXfer->SeqNumber = 1;
+    flashXfer->seqIndex  = NOR_CMD_LUT_SEQ_IDX_SCRATCH;
+    status_t status = FLEXSPI_TransferBlocking(userConfig->mixspiBase, flashXfer);
+
+    FLEXSPI_UpdateLUT(userConfig->mixspiBase, 4 * NOR_CMD_LUT_SEQ_IDX_SCRATCH,
+                      &userConfig->mixspiCustomLUTVendor[4 * NOR_CMD_LUT_SEQ_IDX_SCRATCH], 4);
+
+    return status;
+}
+
+static status_t mtu_mixspi_nor_scratch_command(mixspi_user_config_t *userConfig, uint8_t opcode)
+{
+    flexspi_transfer_t flashXfer;
+    uint32_t lut[4] = {0};
+
+    /* Command is sent on pads and data rate of host write enable, as device may be in QPI/OPI mode.
+       Two command instructions there mean device takes inverted opcode as second byte (OPI). */
+    uint16_t cmd = NOR_LUT_INSTR(userConfig->mixspiCustomLUTVendor, NOR_CMD_LUT_SEQ_IDX_WRITEENABLE * 8);
+    uint16_t ext = NOR_LUT_INSTR(userConfig->mixspiCustomLUTVendor, NOR_CMD_LUT_SEQ_IDX_WRITEENABLE * 8 + 1);
+    uint8_t cmdOpcode = NOR_LUT_INSTR_OPCODE(cmd);
+    uint8_t cmdPads = NOR_LUT_INSTR_PADS(cmd);
+    if ((cmdOpcode != kFLEXSPI_Command_SDR) && (cmdOpcode != kFLEXSPI_Command_DDR))
+    {
+        cmdOpcode = kFLEXSPI_Command_SDR;
+        cmdPads = kFLEXSPI_1PAD;
+    }
+    if (NOR_LUT_INSTR_OPCODE(ext) == cmdOpcode)
+    {
+        lut[0] = FLEXSPI_LUT_SEQ(cmdOpcode, cmdPads, opcode, cmdOpcode, cmdPads, (uint8_t)~opcode);
+    }
+    else
+    {
+        lut[0] = FLEXSPI_LUT_SEQ(cmdOpcode, cmdPads, opcode, kFLEXSPI_Command_STOP, kFLEXSPI_1PAD, 0x00);
+    }
+
+    flashXfer.deviceAddress = 0;
+    flashXfer.cmdType       = kFLEXSPI_Command;
+
+    return mtu_mixspi_nor_scratch_transfer(userConfig, lut, &flashXfer);
+}
+
+status_t mtu_mixspi_nor_read_sfdp(mixspi_user_config_t *userConfig, uint32_t address, uint32_t *buffer, uint32_t size)
+{
+    flexspi_transfer_t flashXfer;
+    /* SFDP always takes 24-bit address and 8 dummy cycles, whatever the address mode of device is */
+    uint32_t lut[4] = {
+        FLEXSPI_LUT_SEQ(kFLEXSPI_Command_SDR, kFLEXSPI_1PAD, NOR_READ_SFDP_OPCODE, kFLEXSPI_Command_RADDR_SDR,
+                        kFLEXSPI_1PAD, 0x18),
+        FLEXSPI_LUT_SEQ(kFLEXSPI_Command_DUMMY_SDR, kFLEXSPI_1PAD, 0x08, kFLEXSPI_Command_READ_SDR, kFLEXSPI_1PAD,
+                        0x04),
+    };
+
+    flashXfer.deviceAddress = address;
+    flashXfer.cmdType       = kFLEXSPI_Read;
+    flashXfer.data          = buffer;
+    flashXfer.dataSize      = size;
+    status_t status = mtu_mixspi_nor_scratch_transfer(userConfig, lut, &flashXfer);
+
+    mtu_mixspi_nor_ahb_sync(userConfig, status, false);
 
     return status;
 }
 
+status_t mtu_mixspi_nor_enter_4byte_mode(mixspi_user_config_t *userConfig)
+{
+    status_t status = mtu_mixspi_nor_write_enable(userConfig, 0, kFlashInstMode_SPI);
+    if (status == kStatus_Success)
+    {
+        status = mtu_mixspi_nor_scratch_command(userConfig, NOR_ENTER_4BYTE_ADDR_OPCODE);
+    }
+    if (status != kStatus_Success)
+    {
+        FLEXSPI_SoftwareReset(userConfig->mixspiBase);
+    }
+    else
+    {
+        s_isNor4ByteMode = true;
+    }
+
+    return status;
+}
+
+status_t mtu_mixspi_nor_exit_4byte_mode(mixspi_user_config_t *userConfig)
+{
+    if (!s_isNor4ByteMode)
+    {
+        return kStatus_Success;
+    }
+
+    status_t status = mtu_mixspi_nor_write_enable(userConfig, 0, kFlashInstMode_SPI);
+    if (status == kStatus_Success)
+    {
+        status = mtu_mixspi_nor_scratch_command(userConfig, NOR_EXIT_4BYTE_ADDR_OPCODE);
+    }
+    if (status != kStatus_Success)
+    {
+        FLEXSPI_SoftwareReset(userConfig->mixspiBase);
+        return status;
+    }
+    s_isNor4ByteMode = false;
+
+    return kStatus_Success;
+}
+
+status_t mtu_mixspi_nor_suspend(mixspi_user_config_t *userConfig)
+{
+    uint32_t polls;
+    mtu_cycle_timer_ensure_running();
+    uint32_t cmdCycles = mtu_cycle_timer_count();
+
+    status_t status = mtu_mixspi_nor_scratch_command(userConfig, s_norSuspendOpcode);
+    if (status != kStatus_Success)
+    {
+        return status;
+    }
+
+    /* Device reports ready once erase/program is suspended and it accepts reads. */
+    uint32_t busyCycles = mtu_cycle_timer_count();
+    cmdCycles = busyCycles - cmdCycles;
+    status = mtu_mixspi_nor_wait_bus_busy(userConfig, kFlashInstMode_SPI, kNorOp_Suspend, &polls);
+    busyCycles = mtu_cycle_timer_count() - busyCycles;
+    mtu_mixspi_nor_op_record(kNorOp_Suspend, cmdCycles, busyCycles, polls);
+
+    mtu_mixspi_nor_ahb_sync(userConfig, status, true);
+
+    return status;
+}
+
+status_t mtu_mixspi_nor_resume(mixspi_user_config_t *userConfig)
+{
+    return mtu_mixspi_nor_scratch_command(userConfig, s_norResumeOpcode);
+}
+
+void mtu_mixspi_nor_set_suspend_opcodes(uint8_t suspendOpcode, uint8_t resumeOpcode)
+{
+    s_norSuspendOpcode = suspendOpcode;
+    s_norResumeOpcode = resumeOpcode;
+}
+
 status_t mtu_mixspi_nor_page_program(mixspi_user_config_t *userConfig,
                                      flexspi_device_config_t *deviceconfig,
                                      uint32_t address,
@@ -440,36 +901,31 @@ status_t mtu_mixspi_nor_page_program(mixspi_user_config_t *userConfig,
     status_t status;
     flexspi_transfer_t flashXfer;
 
-#if defined(MTU_CACHE_MAINTAIN) && MTU_CACHE_MAINTAIN
-    mixspi_cache_status_t cacheStatus;
+#if defined(MTU_CACHE_MAINTAIN) && MTU_CACHE_MAINTAIN && \
+    !(defined(MTU_CACHE_MAINTAIN_BY_RANGE) && MTU_CACHE_MAINTAIN_BY_RANGE)
+    mixspi_cache_status_t cacheStatus = {0};
     mtu_mixspi_nor_disable_cache(&cacheStatus);
 #endif
 
-    mixspi_root_clk_freq_t lastRootClkFreq;
-    if (flashInstMode == kFlashInstMode_Hyper)
+    /* Single page program of HyperFlash switches clock by itself, a session keeps the clock for all pages */
+    bool isOwnHyperSession = (flashInstMode == kFlashInstMode_Hyper) && !s_norHyperSession.isActive;
+    if (isOwnHyperSession)
     {
-        /* Speed down flexspi clock, beacuse 50 MHz timings are only relevant when a burst write is used to load data during
-         * a HyperFlash Word Program command. */
-        lastRootClkFreq = userConfig->mixspiRootClkFreq;
-        userConfig->mixspiRootClkFreq = kMixspiRootClkFreq_50MHz;
-        bsp_mixspi_clock_init(userConfig);
-
-        /* Get current flexspi root clock. */
-        deviceconfig->flexspiRootClk = bsp_mixspi_get_clock(userConfig);
-
-        /* Update DLL value depending on flexspi root clock. */
-        FLEXSPI_UpdateDllValue(userConfig->mixspiBase, deviceconfig, userConfig->mixspiPort);
-
-        /* Do software reset. */
-        FLEXSPI_SoftwareReset(userConfig->mixspiBase);
+        mtu_mixspi_nor_hyper_session_begin(userConfig, deviceconfig);
     }
 
+    /* Clock switch of HyperFlash above is not part of the operation */
+    uint32_t polls;
+    uint32_t busyCycles;
+    mtu_cycle_timer_ensure_running();
+    uint32_t cmdCycles = mtu_cycle_timer_count();
+
     /* Write enable */
     status = mtu_mixspi_nor_write_enable(userConfig, address, flashInstMode);
 
     if (status != kStatus_Success)
     {
-        return status;
+        goto cleanup;
     }
 
     /* Prepare page program command */
@@ -507,40 +963,452 @@ status_t mtu_mixspi_nor_page_program(mixspi_user_config_t *userConfig,
 
     if (status != kStatus_Success)
     {
-        return status;
+        goto cleanup;
     }
 
-    status = mtu_mixspi_nor_wait_bus_busy(userConfig, flashInstMode);
+    busyCycles = mtu_cycle_timer_count();
+    cmdCycles = busyCycles - cmdCycles;
+    status = mtu_mixspi_nor_wait_bus_busy(userConfig, flashInstMode, kNorOp_PageProgram, &polls);
+    busyCycles = mtu_cycle_timer_count() - busyCycles;
+    mtu_mixspi_nor_op_record(kNorOp_PageProgram, cmdCycles, busyCycles, polls);
 
-    if (flashInstMode == kFlashInstMode_Hyper)
+cleanup:
+    /* A failed page must not leave HyperFlash session open and root clock at program speed */
+    if (isOwnHyperSession)
     {
-        /* Speed up flexspi clock for a high read performance. */
-        userConfig->mixspiRootClkFreq = lastRootClkFreq;
-        bsp_mixspi_clock_init(userConfig);
-
-        /* Get current flexspi root clock. */
-        deviceconfig->flexspiRootClk = bsp_mixspi_get_clock(userConfig);
-
-        /* Update DLL value depending on flexspi root clock. */
-        FLEXSPI_UpdateDllValue(userConfig->mixspiBase, deviceconfig, userConfig->mixspiPort);
+        mtu_mixspi_nor_hyper_session_end(userConfig, deviceconfig);
     }
 
-    /* Do software reset or clear AHB buffer directly. */
-#if defined(FSL_FEATURE_SOC_OTFAD_COUNT) && defined(FLEXSPI_AHBCR_CLRAHBRXBUF_MASK) && \
-    defined(FLEXSPI_AHBCR_CLRAHBTXBUF_MASK)
-    userConfig->mixspiBase->AHBCR |= FLEXSPI_AHBCR_CLRAHBRXBUF_MASK | FLEXSPI_AHBCR_CLRAHBTXBUF_MASK;
-    userConfig->mixspiBase->AHBCR &= ~(FLEXSPI_AHBCR_CLRAHBRXBUF_MASK | FLEXSPI_AHBCR_CLRAHBTXBUF_MASK);
-#else
-    FLEXSPI_SoftwareReset(userConfig->mixspiBase);
-#endif
+    mtu_mixspi_nor_ahb_sync(userConfig, status, true);
 
 #if defined(MTU_CACHE_MAINTAIN) && MTU_CACHE_MAINTAIN
+#if defined(MTU_CACHE_MAINTAIN_BY_RANGE) && MTU_CACHE_MAINTAIN_BY_RANGE
+    mtu_mixspi_nor_cache_range_add(userConfig, address, length);
+#else
     mtu_mixspi_nor_enable_cache(cacheStatus);
+#endif
 #endif
 
     return status;
 }
 
+int32_t mtu_mixspi_nor_find_4byte_opcode(uint8_t opcode)
+{
+    for (uint32_t i = 0; i < ARRAY_SIZE(s_nor4ByteOpcodes); i++)
+    {
+        if (s_nor4ByteOpcodes[i][0] == opcode)
+        {
+            return s_nor4ByteOpcodes[i][1];
+        }
+    }
+
+    return -1;
+}
+
+static void mtu_mixspi_nor_lut_set_operand(uint32_t *lut, uint32_t instrIdx, uint8_t operand)
+{
+    uint32_t shift = (instrIdx & 1) * 16;
+    lut[instrIdx / 2] = (lut[instrIdx / 2] & ~(0xFFUL << shift)) | ((uint32_t)operand << shift);
+}
+
+void mtu_mixspi_nor_set_read_seq(mixspi_user_config_t *userConfig, uint32_t *lut, const uint32_t *seq)
+{
+    memcpy(&lut[4 * NOR_CMD_LUT_SEQ_IDX_READ], seq, 16);
+    FLEXSPI_UpdateLUT(userConfig->mixspiBase, 4 * NOR_CMD_LUT_SEQ_IDX_READ, &lut[4 * NOR_CMD_LUT_SEQ_IDX_READ], 4);
+
+    /* AHB buffers may hold data prefetched by previous sequence */
+    FLEXSPI_SoftwareReset(userConfig->mixspiBase);
+}
+
+uint32_t mtu_mixspi_nor_get_read_cycles(const uint32_t *lut, uint8_t *opcode)
+{
+    uint32_t cycles = 0;
+    uint16_t cmd = NOR_LUT_INSTR(lut, NOR_CMD_LUT_SEQ_IDX_READ * 8);
+    *opcode = (NOR_LUT_INSTR_OPCODE(cmd) == kFLEXSPI_Command_SDR) ? NOR_LUT_INSTR_OPERAND(cmd) : 0;
+
+    /* Mode bits take clocks on the pads of their instruction, as dummy cycles do */
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        uint16_t instr = NOR_LUT_INSTR(lut, NOR_CMD_LUT_SEQ_IDX_READ * 8 + i);
+        uint8_t instrOpcode = NOR_LUT_INSTR_OPCODE(instr);
+        uint32_t lines = 1UL << NOR_LUT_INSTR_PADS(instr);
+        if (instrOpcode == kFLEXSPI_Command_STOP)
+        {
+            break;
+        }
+        if (instrOpcode == kFLEXSPI_Command_DUMMY_SDR)
+        {
+            cycles += NOR_LUT_INSTR_OPERAND(instr);
+        }
+        else if ((instrOpcode >= kFLEXSPI_Command_MODE1_SDR) && (instrOpcode <= kFLEXSPI_Command_MODE8_SDR))
+        {
+            uint32_t modeBits = 1UL << (instrOpcode - kFLEXSPI_Command_MODE1_SDR);
+            cycles += (modeBits + lines - 1) / lines;
+        }
+    }
+
+    return cycles;
+}
+
+status_t mtu_mixspi_nor_enable_4byte_addr(mixspi_user_config_t *userConfig, uint32_t *lut)
+{
+    uint32_t addrSeqMap = 0;
+    bool isAllMapped = true;
+    status_t status = kStatus_Success;
+
+    /* Find sequences sending 24-bit address, and whether their commands have 4-byte address opcodes */
+    for (uint32_t seq = 0; seq < CUSTOM_LUT_LENGTH / 4; seq++)
+    {
+        for (uint32_t i = 0; i < 8; i++)
+        {
+            uint16_t instr = NOR_LUT_INSTR(lut, seq * 8 + i);
+            uint8_t opcode = NOR_LUT_INSTR_OPCODE(instr);
+            if (opcode == kFLEXSPI_Command_STOP)
+            {
+                break;
+            }
+            if (((opcode == kFLEXSPI_Command_RADDR_SDR) || (opcode == kFLEXSPI_Command_RADDR_DDR)) &&
+                (NOR_LUT_INSTR_OPERAND(instr) == 24))
+            {
+                addrSeqMap |= 1UL << seq;
+            }
+        }
+        if (addrSeqMap & (1UL << seq))
+        {
+            uint16_t cmd = NOR_LUT_INSTR(lut, seq * 8);
+            if ((NOR_LUT_INSTR_OPCODE(cmd) != kFLEXSPI_Command_SDR) ||
+                (mtu_mixspi_nor_find_4byte_opcode(NOR_LUT_INSTR_OPERAND(cmd)) < 0))
+            {
+                isAllMapped = false;
+            }
+        }
+    }
+    if (!addrSeqMap)
+    {
+        return kStatus_Success;
+    }
+
+    /* Dedicated opcodes keep device in its reset address mode, otherwise whole device enters 4-byte mode */
+    if (!isAllMapped)
+    {
+        status = mtu_mixspi_nor_enter_4byte_mode(userConfig);
+        if (status != kStatus_Success)
+        {
+            return status;
+        }
+    }
+
+    for (uint32_t seq = 0; seq < CUSTOM_LUT_LENGTH / 4; seq++)
+    {
+        if (!(addrSeqMap & (1UL << seq)))
+        {
+            continue;
+        }
+        if (isAllMapped)
+        {
+            uint16_t cmd = NOR_LUT_INSTR(lut, seq * 8);
+            mtu_mixspi_nor_lut_set_operand(lut, seq * 8,
+                                           (uint8_t)mtu_mixspi_nor_find_4byte_opcode(NOR_LUT_INSTR_OPERAND(cmd)));
+        }
+        for (uint32_t i = 0; i < 8; i++)
+        {
+            uint16_t instr = NOR_LUT_INSTR(lut, seq * 8 + i);
+            uint8_t opcode = NOR_LUT_INSTR_OPCODE(instr);
+            if (opcode == kFLEXSPI_Command_STOP)
+            {
+                break;
+            }
+            if ((opcode == kFLEXSPI_Command_RADDR_SDR) || (opcode == kFLEXSPI_Command_RADDR_DDR))
+            {
+                mtu_mixspi_nor_lut_set_operand(lut, seq * 8 + i, 32);
+            }
+        }
+    }
+    printf("Flash uses 4-byte address (%s), LUT sequences mask 0x%x.\r\n",
+           isAllMapped ? "4-byte opcodes" : "4-byte address mode", addrSeqMap);
+
+    /* Update LUT table. */
+    FLEXSPI_UpdateLUT(userConfig->mixspiBase, 0, lut, CUSTOM_LUT_LENGTH);
+    mtu_mixspi_nor_ahb_sync(userConfig, status, true);
+
+    return status;
+}
+
+status_t mtu_mixspi_nor_hyper_session_begin(mixspi_user_config_t *userConfig, flexspi_device_config_t *deviceconfig)
+{
+    if (s_norHyperSession.isActive)
+    {
+        return kStatus_Success;
+    }
+
+    /* Speed down flexspi clock, beacuse 50 MHz timings are only relevant when a burst write is used to load data during
+     * a HyperFlash Word Program command. */
+    s_norHyperSession.lastRootClkFreq = userConfig->mixspiRootClkFreq;
+    userConfig->mixspiRootClkFreq = kMixspiRootClkFreq_50MHz;
+    bsp_mixspi_clock_init(userConfig);
+
+    /* Get current flexspi root clock. */
+    deviceconfig->flexspiRootClk = bsp_mixspi_get_clock(userConfig);
+
+    /* Update DLL value depending on flexspi root clock. */
+    FLEXSPI_UpdateDllValue(userConfig->mixspiBase, deviceconfig, userConfig->mixspiPort);
+
+    /* Do software reset. */
+    FLEXSPI_SoftwareReset(userConfig->mixspiBase);
+
+    s_norHyperSession.isActive = true;
+
+    return kStatus_Success;
+}
+
+void mtu_mixspi_nor_hyper_session_end(mixspi_user_config_t *userConfig, flexspi_device_config_t *deviceconfig)
+{
+    if (!s_norHyperSession.isActive)
+    {
+        return;
+    }
+
+    /* Speed up flexspi clock for a high read performance. */
+    userConfig->mixspiRootClkFreq = s_norHyperSession.lastRootClkFreq;
+    bsp_mixspi_clock_init(userConfig);
+
+    /* Get current flexspi root clock. */
+    deviceconfig->flexspiRootClk = bsp_mixspi_get_clock(userConfig);
+
+    /* Update DLL value depending on flexspi root clock. */
+    FLEXSPI_UpdateDllValue(userConfig->mixspiBase, deviceconfig, userConfig->mixspiPort);
+
+    /* Do software reset. */
+    FLEXSPI_SoftwareReset(userConfig->mixspiBase);
+
+    s_norHyperSession.isActive = false;
+}
+
+static uint32_t mtu_mixspi_nor_write_fetch_linear(void *context, uint32_t maxLen, const uint8_t **data)
+{
+    nor_write_linear_source_t *source = (nor_write_linear_source_t *)context;
+    uint32_t size = (source->remaining < maxLen) ? source->remaining : maxLen;
+
+    *data = source->data;
+    source->data += size;
+    source->remaining -= size;
+
+    return size;
+}
+
+status_t mtu_mixspi_nor_write_stream(mixspi_user_config_t *userConfig,
+                                     flexspi_device_config_t *deviceconfig,
+                                     uint32_t address,
+                                     uint32_t length,
+                                     flash_inst_mode_t flashInstMode,
+                                     nor_write_fetch_t fetch,
+                                     void *context)
+{
+    status_t status = kStatus_Success;
+    uint32_t chunkSize = (flashInstMode == kFlashInstMode_Hyper) ? NOR_HYPER_WRITE_BUFFER_SIZE : MTU_MEM_NOR_PAGE_SIZE;
+
+    /* Clock of HyperFlash is switched once for the whole run */
+    if (flashInstMode == kFlashInstMode_Hyper)
+    {
+        mtu_mixspi_nor_hyper_session_begin(userConfig, deviceconfig);
+    }
+
+    while (length)
+    {
+        /* One command never crosses page (or write buffer) boundary, head and tail may be partial pages */
+        uint32_t size = chunkSize - (address & (chunkSize - 1));
+        if (size > length)
+        {
+            size = length;
+        }
+        /* Source hands out contiguous data in place, a ring buffer wrap just ends this command early */
+        const uint8_t *data;
+        size = fetch(context, size, &data);
+        if (!size)
+        {
+            status = kStatus_Fail;
+            break;
+        }
+        /* TX FIFO is filled by words, misaligned source goes through word buffer */
+        if ((uint32_t)data & 0x3)
+        {
+            memcpy(s_norWriteAlignBuffer, data, size);
+            data = (const uint8_t *)s_norWriteAlignBuffer;
+        }
+        status = mtu_mixspi_nor_page_program(userConfig, deviceconfig, address, (const uint32_t *)data, size,
+                                             flashInstMode);
+        if (status != kStatus_Success)
+        {
+            break;
+        }
+        address += size;
+        length -= size;
+    }
+
+    if (flashInstMode == kFlashInstMode_Hyper)
+    {
+        mtu_mixspi_nor_hyper_session_end(userConfig, deviceconfig);
+    }
+
+    return status;
+}
+
+status_t mtu_mixspi_nor_write(mixspi_user_config_t *userConfig,
+                              flexspi_device_config_t *deviceconfig,
+                              uint32_t address,
+                              const void *src,
+                              uint32_t length,
+                              flash_inst_mode_t flashInstMode)
+{
+    nor_write_linear_source_t source = {(const uint8_t *)src, length};
+
+    return mtu_mixspi_nor_write_stream(userConfig, deviceconfig, address, length, flashInstMode,
+                                       mtu_mixspi_nor_write_fetch_linear, &source);
+}
+
+void mtu_mixspi_nor_set_poll_timing(uint8_t op, uint32_t typicalUs, uint32_t timeoutUs)
+{
+    if (op < kNorOp_MaxIdx)
+    {
+        s_norPollTiming[op].typicalUs = typicalUs;
+        s_norPollTiming[op].timeoutUs = timeoutUs;
+    }
+}
+
+void mtu_mixspi_nor_poll_timing_reset(void)
+{
+    memcpy(s_norPollTiming, s_norPollTimingDefault, sizeof(s_norPollTiming));
+}
+
+void mtu_mixspi_nor_set_poll_precise(bool isPrecise)
+{
+    s_isNorPollPrecise = isPrecise;
+}
+
+void mtu_mixspi_nor_op_stats_reset(void)
+{
+    memset(s_norOpStat, 0, sizeof(s_norOpStat));
+}
+
+void mtu_mixspi_nor_op_stats_print(void)
+{
+    float cyclesPerUs = (float)mtu_cycle_timer_clocks_per_sec() / 1000000;
+    for (uint32_t op = 0; op < kNorOp_MaxIdx; op++)
+    {
+        nor_op_stat_t *stat = &s_norOpStat[op];
+        if (!stat->count)
+        {
+            continue;
+        }
+        // Busy time per poll is what one status read costs, it bounds the extra latency after device is ready
+        printf("%s: %d ops, command avg %.2f us, busy avg %.2f us max %.2f us, polls avg %d max %d (%.2f us/poll)\r\n",
+               s_norOpName[op], stat->count, (float)stat->cmdCycles / stat->count / cyclesPerUs,
+               (float)stat->busyCycles / stat->count / cyclesPerUs, (float)stat->maxBusyCycles / cyclesPerUs,
+               stat->polls / stat->count, stat->maxPolls,
+               stat->polls ? ((float)stat->busyCycles / stat->polls / cyclesPerUs) : 0.0f);
+        // Device got ready somewhere in the wait before its last poll, busy time may overshoot by that much
+        printf("  busy time resolution %d us\r\n", stat->maxResolutionUs);
+        for (uint32_t bucket = 0; bucket < NOR_OP_HIST_BUCKETS; bucket++)
+        {
+            if (stat->cmdHist[bucket] || stat->busyHist[bucket])
+            {
+                printf("  [%10.2f, %10.2f) us: command %8d, busy %8d\r\n", (float)(1UL << bucket) / cyclesPerUs,
+                       (float)(2ULL << bucket) / cyclesPerUs, stat->cmdHist[bucket], stat->busyHist[bucket]);
+            }
+        }
+    }
+}
+
+static void mtu_mixspi_ahb_buf_fill(mixspi_user_config_t *userConfig, flexspi_config_t *config)
+{
+    mixspi_ahb_buf_config_t *ahbBuf = &userConfig->ahbBufConfig;
+    uint32_t bufferCount = ARRAY_SIZE(config->ahbConfig.buffer);
+
+    config->ahbConfig.enableAHBPrefetch = ahbBuf->enablePrefetch;
+    for (uint32_t i = 0; i < bufferCount; i++)
+    {
+        config->ahbConfig.buffer[i].enablePrefetch = ahbBuf->enablePrefetch;
+    }
+    /* First buffer is unused by default layout, it serves the dedicated master. */
+    if (ahbBuf->masterId != MIXSPI_AHB_BUF_NO_MASTER)
+    {
+        config->ahbConfig.buffer[0].masterIndex = ahbBuf->masterId;
+        config->ahbConfig.buffer[0].priority    = ahbBuf->masterPriority;
+        config->ahbConfig.buffer[0].bufferSize  = ahbBuf->masterBufSize;
+    }
+    /* Last buffer takes all masters not assigned to other buffers. */
+    if (ahbBuf->sharedBufSize)
+    {
+        config->ahbConfig.buffer[bufferCount - 1].bufferSize = ahbBuf->sharedBufSize;
+    }
+
+    /* Layout never exceeds buffer RAM, dedicated buffer is cut first, then shared one. */
+    uint32_t totalSize = 0;
+    for (uint32_t i = 0; i < bufferCount; i++)
+    {
+        totalSize += config->ahbConfig.buffer[i].bufferSize;
+    }
+    if (totalSize <= MIXSPI_AHB_RX_BUF_TOTAL_SIZE)
+    {
+        return;
+    }
+    uint32_t excess = totalSize - MIXSPI_AHB_RX_BUF_TOTAL_SIZE;
+    uint32_t cutIdx[] = {0, bufferCount - 1};
+    for (uint32_t i = 0; (i < ARRAY_SIZE(cutIdx)) && excess; i++)
+    {
+        flexspi_ahbBuffer_config_t *buffer = &config->ahbConfig.buffer[cutIdx[i]];
+        if ((cutIdx[i] == 0) && (ahbBuf->masterId == MIXSPI_AHB_BUF_NO_MASTER))
+        {
+            continue;
+        }
+        uint32_t cut = (excess > buffer->bufferSize) ? buffer->bufferSize : excess;
+        buffer->bufferSize -= cut;
+        excess -= cut;
+    }
+    if (ahbBuf->masterId != MIXSPI_AHB_BUF_NO_MASTER)
+    {
+        ahbBuf->masterBufSize = config->ahbConfig.buffer[0].bufferSize;
+    }
+    if (ahbBuf->sharedBufSize)
+    {
+        ahbBuf->sharedBufSize = config->ahbConfig.buffer[bufferCount - 1].bufferSize;
+    }
+    printf("WARNING: AHB RX buffers are cut to %d bytes of buffer RAM.\r\n", MIXSPI_AHB_RX_BUF_TOTAL_SIZE);
+}
+
+void mtu_mixspi_set_ahb_buffer(mixspi_user_config_t *userConfig)
+{
+    MIXSPI_Type *base = userConfig->mixspiBase;
+    flexspi_config_t config;
+    FLEXSPI_GetDefaultConfig(&config);
+    mtu_mixspi_ahb_buf_fill(userConfig, &config);
+
+    /* Wait for bus to be idle before changing buffer layout. */
+    while (!FLEXSPI_GetBusIdleStatus(base))
+    {
+    }
+    FLEXSPI_Enable(base, false);
+    base->AHBCR = (base->AHBCR & ~(FLEXSPI_AHBCR_PREFETCHEN_MASK | FLEXSPI_AHBCR_ALIGNMENT_MASK)) |
+                  FLEXSPI_AHBCR_PREFETCHEN(config.ahbConfig.enableAHBPrefetch) |
+                  FLEXSPI_AHBCR_ALIGNMENT(userConfig->ahbBufConfig.alignment);
+    for (uint32_t i = 0; i < ARRAY_SIZE(config.ahbConfig.buffer); i++)
+    {
+        flexspi_ahbBuffer_config_t *buffer = &config.ahbConfig.buffer[i];
+        base->AHBRXBUFCR0[i] = (base->AHBRXBUFCR0[i] & ~(FLEXSPI_AHBRXBUFCR0_PREFETCHEN_MASK |
+                                                         FLEXSPI_AHBRXBUFCR0_PRIORITY_MASK |
+                                                         FLEXSPI_AHBRXBUFCR0_MSTRID_MASK |
+                                                         FLEXSPI_AHBRXBUFCR0_BUFSZ_MASK)) |
+                               FLEXSPI_AHBRXBUFCR0_PREFETCHEN(buffer->enablePrefetch) |
+                               FLEXSPI_AHBRXBUFCR0_PRIORITY(buffer->priority) |
+                               FLEXSPI_AHBRXBUFCR0_MSTRID(buffer->masterIndex) |
+                               FLEXSPI_AHBRXBUFCR0_BUFSZ((uint32_t)buffer->bufferSize / 8U);
+    }
+    FLEXSPI_Enable(base, true);
+
+    /* Do software reset, it also drops data of previous layout. */
+    FLEXSPI_SoftwareReset(base);
+}
+
 void mtu_mixspi_mem_init(mixspi_user_config_t *userConfig, 
                                flexspi_device_config_t *deviceconfig)
 {
@@ -553,11 +1421,11 @@ void mtu_mixspi_mem_init(mixspi_user_config_t *userConfig,
     FLEXSPI_GetDefaultConfig(&config);
 
     /*Set AHB buffer size for reading data through AHB bus. */
-    config.ahbConfig.enableAHBPrefetch    = true;
     config.ahbConfig.enableAHBBufferable  = true;
     config.ahbConfig.enableReadAddressOpt = true;
     config.ahbConfig.enableAHBCachable    = true;
     config.rxSampleClock                  = userConfig->mixspiReadSampleClock;
+    mtu_mixspi_ahb_buf_fill(userConfig, &config);
 #if !(defined(FSL_FEATURE_FLEXSPI_HAS_NO_MCR0_COMBINATIONEN) && FSL_FEATURE_FLEXSPI_HAS_NO_MCR0_COMBINATIONEN)
     flexspi_port_t port = userConfig->mixspiPort;
     if ((port == kFLEXSPI_PortA1) || (port == kFLEXSPI_PortA2))
@@ -573,7 +1441,7 @@ void mtu_mixspi_mem_init(mixspi_user_config_t *userConfig,
 
     /* Set alignment, otherwise the prefetch burst may cross die boundary. */
     userConfig->mixspiBase->AHBCR &= ~FLEXSPI_AHBCR_ALIGNMENT_MASK;
-    userConfig->mixspiBase->AHBCR |= FLEXSPI_AHBCR_ALIGNMENT(1);/* 1KB */
+    userConfig->mixspiBase->AHBCR |= FLEXSPI_AHBCR_ALIGNMENT(userConfig->ahbBufConfig.alignment);
 
     /* Configure flash settings according to serial flash feature. */
     FLEXSPI_SetFlashConfig(userConfig->mixspiBase, deviceconfig, userConfig->mixspiPort);
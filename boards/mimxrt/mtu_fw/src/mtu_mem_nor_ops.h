@@ -45,6 +45,26 @@
 #define NOR_CMD_LUT_SEQ_IDX_PAGEPROGRAM_OPI 15
 
 #define NOR_CMD_LUT_SEQ_IDX_WRITE           9
+// Slot of SETDUMMY is not issued by firmware, it is borrowed for one-shot commands (suspend/resume)
+#define NOR_CMD_LUT_SEQ_IDX_SCRATCH         5
+
+//! @brief Fields of one 16-bit LUT instruction, instrIdx counts instructions from LUT start.
+#define NOR_LUT_INSTR(lut, instrIdx)  ((uint16_t)((lut)[(instrIdx) / 2] >> (((instrIdx) & 1) * 16)))
+#define NOR_LUT_INSTR_OPCODE(instr)   (((instr) >> 10) & 0x3F)
+#define NOR_LUT_INSTR_PADS(instr)     (((instr) >> 8) & 0x3)
+#define NOR_LUT_INSTR_OPERAND(instr)  ((instr) & 0xFF)
+
+// HyperFlash write buffer, one word program command loads up to this many bytes
+#define NOR_HYPER_WRITE_BUFFER_SIZE         512
+
+// Default erase/program suspend and resume commands for devices without SFDP, sent in command mode of host WREN
+#define NOR_SUSPEND_OPCODE                  0x75
+#define NOR_RESUME_OPCODE                   0x7A
+// Enter/exit 4-byte address mode, used when a command has no dedicated 4-byte address opcode
+#define NOR_ENTER_4BYTE_ADDR_OPCODE         0xB7
+#define NOR_EXIT_4BYTE_ADDR_OPCODE          0xE9
+// Read SFDP (JESD216) tables, 1-pad SPI
+#define NOR_READ_SFDP_OPCODE                0x5A
 
 // Supported Flash inst mode
 typedef enum _flash_inst_mode
@@ -78,12 +98,95 @@ typedef struct _flash_reg_access
     } regValue;
 } flash_reg_access_t;
 
+//! @brief Instrumented NOR operations.
+enum _nor_ops
+{
+    kNorOp_EraseSector   = 0x00,
+    kNorOp_PageProgram   = 0x01,
+    kNorOp_WriteRegister = 0x02,
+    kNorOp_Suspend       = 0x03,
+    kNorOp_MaxIdx,
+};
+
+//! @brief Default busy polling timing of operations. Status is first read after most of typical
+//!        time has passed, then at intervals doubling from the minimum one until ready or timeout.
+//!        Precise polling skips the initial delay and keeps the minimum interval, for timing runs.
+#define NOR_ERASE_SECTOR_TYPICAL_US         (20000)
+// Worst case of HyperFlash 256KB sector and SPI 64KB block erase, SFDP of the device may narrow it
+#define NOR_ERASE_SECTOR_TIMEOUT_US         (4000000)
+#define NOR_ERASE_SECTOR_MIN_INTERVAL_US    (50)
+#define NOR_PAGE_PROGRAM_TYPICAL_US         (200)
+#define NOR_PAGE_PROGRAM_TIMEOUT_US         (10000)
+#define NOR_PAGE_PROGRAM_MIN_INTERVAL_US    (5)
+#define NOR_WRITE_REGISTER_TYPICAL_US       (0)
+#define NOR_WRITE_REGISTER_TIMEOUT_US       (100000)
+#define NOR_WRITE_REGISTER_MIN_INTERVAL_US  (20)
+#define NOR_SUSPEND_TYPICAL_US              (0)
+#define NOR_SUSPEND_TIMEOUT_US              (1000)
+#define NOR_SUSPEND_MIN_INTERVAL_US         (5)
+#define NOR_POLL_INITIAL_DELAY_PERCENT      (75)
+#define NOR_POLL_MAX_INTERVAL_US            (1000)
+
+//! @brief AHB RX buffer RAM shared by all buffers, of the smallest FlexSPI instance supported.
+#define MIXSPI_AHB_RX_BUF_TOTAL_SIZE   (1024)
+
+//! @brief Busy polling timing of one operation type.
+typedef struct _nor_poll_timing
+{
+    uint32_t typicalUs;
+    uint32_t timeoutUs;
+    uint32_t minIntervalUs;
+} nor_poll_timing_t;
+
+//! @brief Operation histograms have log2 buckets of CPU cycles.
+#define NOR_OP_HIST_BUCKETS 32
+
+//! @brief Timing of one NOR operation type, split into command phase (write enable + command)
+//!        and busy phase (status polling until device is ready).
+typedef struct _nor_op_stat
+{
+    uint32_t count;
+    uint32_t polls;
+    uint32_t maxPolls;
+    uint32_t maxBusyCycles;
+    uint32_t maxResolutionUs;   // Longest wait before the poll that found device ready, busy time is within it
+    uint64_t cmdCycles;
+    uint64_t busyCycles;
+    uint32_t cmdHist[NOR_OP_HIST_BUCKETS];
+    uint32_t busyHist[NOR_OP_HIST_BUCKETS];
+} nor_op_stat_t;
+
+//! @brief How AHB buffers are brought in sync after IP commands.
+enum _nor_ahb_sync_policies
+{
+    kNorAhbSync_Reset       = 0x00,    // FlexSPI software reset after every command
+    kNorAhbSync_ClearBuffer = 0x01,    // Clear AHB RX/TX buffers after array changes only, reset on error
+    kNorAhbSync_MaxIdx,
+};
+
+//! @brief HyperFlash program clock switch, kept over a run of pages.
+typedef struct _nor_hyper_session
+{
+    bool isActive;
+    mixspi_root_clk_freq_t lastRootClkFreq;
+} nor_hyper_session_t;
+
+//! @brief Source of streamed write, it gives up to maxLen contiguous bytes in place and returns their count.
+typedef uint32_t (*nor_write_fetch_t)(void *context, uint32_t maxLen, const uint8_t **data);
+
+typedef struct _nor_write_linear_source
+{
+    const uint8_t *data;
+    uint32_t remaining;
+} nor_write_linear_source_t;
+
 typedef struct _mixspi_cache_status
 {
     volatile bool DCacheEnableFlag;
     volatile bool ICacheEnableFlag;
     volatile bool codeCacheEnableFlag;
     volatile bool systemCacheEnableFlag;
+    volatile bool CacheEnableFlag;
 } mixspi_cache_status_t;
 
 /*******************************************************************************
@@ -98,6 +201,8 @@ extern mixspi_user_config_t s_userConfig;
 
 void mtu_mixspi_mem_init(mixspi_user_config_t *userConfig, flexspi_device_config_t *deviceconfig);
 
+void mtu_mixspi_set_ahb_buffer(mixspi_user_config_t *userConfig);
+
 status_t mtu_mixspi_nor_get_jedec_id(mixspi_user_config_t *userConfig, uint32_t *vendorId);
 
 status_t mtu_mixspi_nor_write_register(mixspi_user_config_t *userConfig, flash_reg_access_t *regAccess);
@@ -108,6 +213,18 @@ status_t mtu_mixspi_nor_enable_quad_mode(mixspi_user_config_t *userConfig);
 
 status_t mtu_mixspi_nor_erase_sector(mixspi_user_config_t *userConfig, uint32_t address, flash_inst_mode_t flashInstMode);
 
+status_t mtu_mixspi_nor_erase_sector_start(mixspi_user_config_t *userConfig, uint32_t address, flash_inst_mode_t flashInstMode);
+
+status_t mtu_mixspi_nor_wait_ready(mixspi_user_config_t *userConfig, flash_inst_mode_t flashInstMode, uint8_t op, uint32_t *pollCount);
+
+status_t mtu_mixspi_nor_read_busy(mixspi_user_config_t *userConfig, flash_inst_mode_t flashInstMode, bool *isBusy);
+
+status_t mtu_mixspi_nor_suspend(mixspi_user_config_t *userConfig);
+
+status_t mtu_mixspi_nor_resume(mixspi_user_config_t *userConfig);
+
+void mtu_mixspi_nor_set_suspend_opcodes(uint8_t suspendOpcode, uint8_t resumeOpcode);
+
 status_t mtu_mixspi_nor_page_program(mixspi_user_config_t *userConfig,
                                      flexspi_device_config_t *deviceconfig,
                                      uint32_t address,
@@ -115,4 +232,59 @@ status_t mtu_mixspi_nor_page_program(mixspi_user_config_t *userConfig,
                                      uint32_t length,
                                      flash_inst_mode_t flashInstMode);
 
+void mtu_mixspi_nor_disable_cache(mixspi_cache_status_t *cacheStatus);
+
+void mtu_mixspi_nor_enable_cache(mixspi_cache_status_t cacheStatus);
+
+void mtu_mixspi_nor_invalidate_cache_range(uint32_t ambaAddr, uint32_t size);
+
+void mtu_mixspi_nor_cache_sync(void);
+
+uint32_t mtu_mixspi_nor_get_read_cycles(const uint32_t *lut, uint8_t *opcode);
+
+void mtu_mixspi_nor_set_read_seq(mixspi_user_config_t *userConfig, uint32_t *lut, const uint32_t *seq);
+
+int32_t mtu_mixspi_nor_find_4byte_opcode(uint8_t opcode);
+
+status_t mtu_mixspi_nor_enable_4byte_addr(mixspi_user_config_t *userConfig, uint32_t *lut);
+
+status_t mtu_mixspi_nor_enter_4byte_mode(mixspi_user_config_t *userConfig);
+
+status_t mtu_mixspi_nor_exit_4byte_mode(mixspi_user_config_t *userConfig);
+
+status_t mtu_mixspi_nor_read_sfdp(mixspi_user_config_t *userConfig, uint32_t address, uint32_t *buffer, uint32_t size);
+
+status_t mtu_mixspi_nor_hyper_session_begin(mixspi_user_config_t *userConfig, flexspi_device_config_t *deviceconfig);
+
+void mtu_mixspi_nor_hyper_session_end(mixspi_user_config_t *userConfig, flexspi_device_config_t *deviceconfig);
+
+status_t mtu_mixspi_nor_write_stream(mixspi_user_config_t *userConfig,
+                                     flexspi_device_config_t *deviceconfig,
+                                     uint32_t address,
+                                     uint32_t length,
+                                     flash_inst_mode_t flashInstMode,
+                                     nor_write_fetch_t fetch,
+                                     void *context);
+
+status_t mtu_mixspi_nor_write(mixspi_user_config_t *userConfig,
+                              flexspi_device_config_t *deviceconfig,
+                              uint32_t address,
+                              const void *src,
+                              uint32_t length,
+                              flash_inst_mode_t flashInstMode);
+
+void mtu_mixspi_nor_set_ahb_sync_policy(uint8_t policy);
+
+uint8_t mtu_mixspi_nor_get_ahb_sync_policy(void);
+
+void mtu_mixspi_nor_set_poll_timing(uint8_t op, uint32_t typicalUs, uint32_t timeoutUs);
+
+void mtu_mixspi_nor_poll_timing_reset(void);
+
+void mtu_mixspi_nor_set_poll_precise(bool isPrecise);
+
+void mtu_mixspi_nor_op_stats_reset(void);
+
+void mtu_mixspi_nor_op_stats_print(void);
+
 #endif /* _MTU_MEM_NOR_OPS_H_ */
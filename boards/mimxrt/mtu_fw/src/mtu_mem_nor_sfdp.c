@@ -0,0 +1,450 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "mtu_mem_nor_sfdp.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+//! @brief One 16-bit LUT instruction, STOP fills the rest of sequence.
+#define NOR_SFDP_LUT_INSTR(cmd, pad, operand) ((uint16_t)FLEXSPI_LUT_SEQ(cmd, pad, operand, 0, 0, 0))
+
+//! @brief Bits of 4-byte address instruction table DW1.
+#define NOR_SFDP_4B_PAGE_PROGRAM_1_1_1        (1UL << 6)
+#define NOR_SFDP_4B_ERASE_TYPE_SHIFT          (9)
+
+//! @brief Enter 4-byte address methods of BFPT DW16, B7h with or without write enable.
+#define NOR_SFDP_ENTER_4B_BY_B7               (0x03)
+
+//! @brief Quad enable method of BFPT QE requirement, written through ENABLEQE sequence.
+typedef struct _nor_sfdp_qe_method
+{
+    uint8_t opcode;
+    uint8_t bytes;
+    uint16_t value;
+} nor_sfdp_qe_method_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+static void mtu_flash_sfdp_parse_bfpt(const uint32_t *bfpt, uint32_t dwords, nor_sfdp_info_t *info);
+
+static void mtu_flash_sfdp_set_seq(uint32_t *lut, uint32_t seqIdx, const uint16_t *instrs, uint32_t count);
+
+static uint8_t mtu_flash_sfdp_pick_read_mode(const nor_sfdp_info_t *info, bool isQuadAllowed);
+
+/*******************************************************************************
+ * Variables
+ *****************************************************************************/
+
+static nor_sfdp_info_t s_flashSfdpInfo;
+
+static uint32_t s_flashSfdpTable[NOR_SFDP_BFPT_MAX_DWORDS];
+
+static const char *const s_flashSfdpReadModeName[kNorSfdpRead_MaxIdx] = {"1-1-1", "1-1-2", "1-2-2", "1-1-4",
+                                                                          "1-4-4"};
+
+//! @brief FlexSPI pads of address and data phases, per read mode.
+static const uint8_t s_flashSfdpReadPads[kNorSfdpRead_MaxIdx][2] = {
+    {kFLEXSPI_1PAD, kFLEXSPI_1PAD}, {kFLEXSPI_1PAD, kFLEXSPI_2PAD}, {kFLEXSPI_2PAD, kFLEXSPI_2PAD},
+    {kFLEXSPI_1PAD, kFLEXSPI_4PAD}, {kFLEXSPI_4PAD, kFLEXSPI_4PAD},
+};
+
+//! @brief 4-byte address read opcodes, and their bits in 4-byte address instruction table DW1.
+static const uint8_t s_flashSfdpRead4ByteOpcode[kNorSfdpRead_MaxIdx] = {0x0C, 0x3C, 0xBC, 0x6C, 0xEC};
+static const uint8_t s_flashSfdpRead4ByteBit[kNorSfdpRead_MaxIdx] = {1, 2, 3, 4, 5};
+
+//! @brief QE requirement 0-7. Status register 1 is written as 0 by two byte methods.
+static const nor_sfdp_qe_method_t s_flashSfdpQeMethods[8] = {
+    {0x00, 0, 0x0000},    // No QE bit
+    {0x01, 2, 0x0200},    // SR2 bit1, written with SR1
+    {0x01, 1, 0x0040},    // SR1 bit6
+    {0x3E, 1, 0x0080},    // SR2 bit7, own write command
+    {0x01, 2, 0x0200},    // SR2 bit1, written with SR1
+    {0x01, 2, 0x0200},    // SR2 bit1, written with SR1
+    {0x31, 1, 0x0002},    // SR2 bit1, own write command
+    {0x00, 0, 0x0000},    // Reserved
+};
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static void mtu_flash_sfdp_parse_bfpt(const uint32_t *bfpt, uint32_t dwords, nor_sfdp_info_t *info)
+{
+    uint32_t dw1 = bfpt[0];
+    info->addrBytes = (dw1 >> 17) & 0x3;
+
+    // Density is in bits, either N-1 or 2^N
+    if (bfpt[1] & 0x80000000UL)
+    {
+        uint32_t sizeLog2 = (bfpt[1] & 0x7FFFFFFFUL) - 3;
+        info->sizeInBytes = (sizeLog2 < 32) ? (1UL << sizeLog2) : 0x80000000UL;
+    }
+    else
+    {
+        info->sizeInBytes = (bfpt[1] >> 3) + 1;
+    }
+
+    // Fast read (0Bh) has no BFPT entry, every SFDP device supports it
+    info->readModeMap = 1UL << kNorSfdpRead_1_1_1;
+    info->readModes[kNorSfdpRead_1_1_1].opcode = 0x0B;
+    info->readModes[kNorSfdpRead_1_1_1].dummyClocks = 8;
+    const struct
+    {
+        uint8_t mode;
+        uint8_t supportBit;
+        uint8_t dword;
+        uint8_t shift;
+    } readFields[] = {
+        {kNorSfdpRead_1_1_2, 16, 4, 0},
+        {kNorSfdpRead_1_2_2, 20, 4, 16},
+        {kNorSfdpRead_1_1_4, 22, 3, 16},
+        {kNorSfdpRead_1_4_4, 21, 3, 0},
+    };
+    for (uint32_t i = 0; i < ARRAY_SIZE(readFields); i++)
+    {
+        if (!(dw1 & (1UL << readFields[i].supportBit)))
+        {
+            continue;
+        }
+        uint32_t field = bfpt[readFields[i].dword - 1] >> readFields[i].shift;
+        nor_sfdp_read_mode_t *readMode = &info->readModes[readFields[i].mode];
+        readMode->dummyClocks = field & 0x1F;
+        readMode->modeClocks = (field >> 5) & 0x7;
+        readMode->opcode = (field >> 8) & 0xFF;
+        info->readModeMap |= 1UL << readFields[i].mode;
+    }
+
+    for (uint32_t i = 0; i < NOR_SFDP_ERASE_TYPES; i++)
+    {
+        uint32_t field = bfpt[7 + i / 2] >> ((i & 1) * 16);
+        if ((field & 0xFF) && ((field & 0xFF) < 32))
+        {
+            info->eraseTypes[i].size = 1UL << (field & 0xFF);
+            info->eraseTypes[i].opcode = (field >> 8) & 0xFF;
+        }
+    }
+
+    // JESD216A and later: erase/program times, page size, QE and 4-byte address methods
+    info->pageSize = MTU_MEM_NOR_PAGE_SIZE;
+    info->quadEnableReq = NOR_SFDP_QE_UNKNOWN;
+    if (dwords >= 11)
+    {
+        const uint32_t eraseUnitUs[4] = {1000, 16000, 128000, 1000000};
+        uint32_t eraseMultiplier = 2 * ((bfpt[9] & 0xF) + 1);
+        for (uint32_t i = 0; i < NOR_SFDP_ERASE_TYPES; i++)
+        {
+            uint32_t field = bfpt[9] >> (4 + 7 * i);
+            info->eraseTypes[i].typicalUs = ((field & 0x1F) + 1) * eraseUnitUs[(field >> 5) & 0x3];
+            info->eraseTypes[i].timeoutUs = info->eraseTypes[i].typicalUs * eraseMultiplier;
+        }
+        uint32_t dw11 = bfpt[10];
+        info->pageSize = 1UL << ((dw11 >> 4) & 0xF);
+        info->pageProgramTypicalUs = (((dw11 >> 8) & 0x1F) + 1) * ((dw11 & (1UL << 13)) ? 64 : 8);
+        info->pageProgramTimeoutUs = info->pageProgramTypicalUs * 2 * ((dw11 & 0xF) + 1);
+    }
+    if (dwords >= 13)
+    {
+        info->hasSuspend = ((bfpt[11] & (1UL << 31)) == 0);
+        info->suspendOpcode = (uint8_t)(bfpt[12] >> 24);
+        info->resumeOpcode = (uint8_t)(bfpt[12] >> 16);
+    }
+    if (dwords >= 15)
+    {
+        info->quadEnableReq = (bfpt[14] >> 20) & 0x7;
+    }
+    if (dwords >= 16)
+    {
+        info->enter4ByteMethods = bfpt[15] >> 24;
+    }
+}
+
+status_t mtu_flash_sfdp_read(mixspi_user_config_t *userConfig, nor_sfdp_info_t *info)
+{
+    uint32_t headers[2 + 2 * NOR_SFDP_MAX_PARAM_HEADERS];
+    uint32_t bfptAddr = 0, bfptDwords = 0;
+    uint32_t instr4ByteAddr = 0, instr4ByteDwords = 0;
+
+    memset(info, 0, sizeof(nor_sfdp_info_t));
+    status_t status = mtu_mixspi_nor_read_sfdp(userConfig, 0, headers, 8);
+    if (status != kStatus_Success)
+    {
+        return status;
+    }
+    if (headers[0] != NOR_SFDP_SIGNATURE)
+    {
+        printf("Flash has no SFDP signature (0x%x).\r\n", headers[0]);
+        return kStatus_Fail;
+    }
+    info->minorRev = headers[1] & 0xFF;
+    info->majorRev = (headers[1] >> 8) & 0xFF;
+    uint32_t paramHeaders = ((headers[1] >> 16) & 0xFF) + 1;
+    if (paramHeaders > NOR_SFDP_MAX_PARAM_HEADERS)
+    {
+        paramHeaders = NOR_SFDP_MAX_PARAM_HEADERS;
+    }
+    status = mtu_mixspi_nor_read_sfdp(userConfig, 8, &headers[2], paramHeaders * 8);
+    if (status != kStatus_Success)
+    {
+        return status;
+    }
+
+    for (uint32_t i = 0; i < paramHeaders; i++)
+    {
+        uint32_t header0 = headers[2 + 2 * i];
+        uint32_t header1 = headers[3 + 2 * i];
+        uint32_t id = ((header1 >> 16) & 0xFF00) | (header0 & 0xFF);
+        uint32_t dwords = header0 >> 24;
+        // Later BFPT revisions extend the first one, the longest is kept
+        if ((id == NOR_SFDP_ID_BFPT) && (dwords > bfptDwords))
+        {
+            bfptAddr = header1 & 0xFFFFFF;
+            bfptDwords = dwords;
+        }
+        else if (id == NOR_SFDP_ID_4BYTE_ADDR)
+        {
+            instr4ByteAddr = header1 & 0xFFFFFF;
+            instr4ByteDwords = dwords;
+        }
+        else if (id == NOR_SFDP_ID_XSPI_PROFILE1)
+        {
+            info->hasXspiProfile = true;
+        }
+    }
+    // JESD216 BFPT has 9 dwords at least
+    if (bfptDwords < 9)
+    {
+        printf("Flash SFDP has no valid basic flash parameter table.\r\n");
+        return kStatus_Fail;
+    }
+    if (bfptDwords > NOR_SFDP_BFPT_MAX_DWORDS)
+    {
+        bfptDwords = NOR_SFDP_BFPT_MAX_DWORDS;
+    }
+    status = mtu_mixspi_nor_read_sfdp(userConfig, bfptAddr, s_flashSfdpTable, bfptDwords * 4);
+    if (status != kStatus_Success)
+    {
+        return status;
+    }
+    mtu_flash_sfdp_parse_bfpt(s_flashSfdpTable, bfptDwords, info);
+
+    if (instr4ByteDwords >= 2)
+    {
+        status = mtu_mixspi_nor_read_sfdp(userConfig, instr4ByteAddr, s_flashSfdpTable, 8);
+        if (status != kStatus_Success)
+        {
+            return status;
+        }
+        info->instr4ByteMap = s_flashSfdpTable[0];
+        for (uint32_t i = 0; i < NOR_SFDP_ERASE_TYPES; i++)
+        {
+            if (info->instr4ByteMap & (1UL << (NOR_SFDP_4B_ERASE_TYPE_SHIFT + i)))
+            {
+                info->eraseTypes[i].opcode4B = (s_flashSfdpTable[1] >> (8 * i)) & 0xFF;
+            }
+        }
+    }
+
+    return kStatus_Success;
+}
+
+static void mtu_flash_sfdp_set_seq(uint32_t *lut, uint32_t seqIdx, const uint16_t *instrs, uint32_t count)
+{
+    memset(&lut[4 * seqIdx], 0, 16);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        lut[4 * seqIdx + i / 2] |= (uint32_t)instrs[i] << ((i & 1) * 16);
+    }
+}
+
+static uint8_t mtu_flash_sfdp_pick_read_mode(const nor_sfdp_info_t *info, bool isQuadAllowed)
+{
+    for (uint8_t readMode = kNorSfdpRead_MaxIdx - 1; readMode > kNorSfdpRead_1_1_1; readMode--)
+    {
+        if ((info->readModeMap & (1UL << readMode)) &&
+            (isQuadAllowed || (s_flashSfdpReadPads[readMode][1] != kFLEXSPI_4PAD)))
+        {
+            return readMode;
+        }
+    }
+
+    return kNorSfdpRead_1_1_1;
+}
+
+status_t mtu_flash_sfdp_configure(mixspi_user_config_t *userConfig, uint32_t *lut)
+{
+    nor_sfdp_info_t *info = &s_flashSfdpInfo;
+    memory_property_t *memProperty = &s_configSystemPacket.memProperty;
+    status_t status = mtu_flash_sfdp_read(userConfig, info);
+    if (status != kStatus_Success)
+    {
+        return status;
+    }
+
+    // Quad lines need a QE method, from SFDP or from host config
+    bool isQuadAllowed = (memProperty->type == kMemType_QuadSPI) &&
+                         ((info->quadEnableReq != NOR_SFDP_QE_UNKNOWN) || memProperty->flashQuadEnableBytes);
+    uint8_t readMode = mtu_flash_sfdp_pick_read_mode(info, isQuadAllowed);
+    const nor_sfdp_erase_type_t *sectorErase = NULL;
+    for (uint32_t i = 0; i < NOR_SFDP_ERASE_TYPES; i++)
+    {
+        if (info->eraseTypes[i].size == MTU_MEM_NOR_SECTOR_SIZE)
+        {
+            sectorErase = &info->eraseTypes[i];
+            break;
+        }
+    }
+
+    // Dedicated 4-byte opcodes are preferred, device address mode is changed only if some are missing
+    uint8_t addrBits = 24;
+    bool is4ByteOpcodes = false;
+    bool isEnter4ByteMode = false;
+    if ((info->sizeInBytes > MTU_MEM_NOR_3B_ADDR_MAX_SIZE) || (info->addrBytes == 2))
+    {
+        addrBits = 32;
+        is4ByteOpcodes = (info->instr4ByteMap & (1UL << s_flashSfdpRead4ByteBit[readMode])) &&
+                         (info->instr4ByteMap & NOR_SFDP_4B_PAGE_PROGRAM_1_1_1) &&
+                         ((sectorErase == NULL) || sectorErase->opcode4B);
+        if (!is4ByteOpcodes && (info->addrBytes != 2))
+        {
+            if (info->enter4ByteMethods && !(info->enter4ByteMethods & NOR_SFDP_ENTER_4B_BY_B7))
+            {
+                printf("Flash enters 4-byte address mode by methods 0x%x only, not supported.\r\n",
+                       info->enter4ByteMethods);
+                return kStatus_Fail;
+            }
+            isEnter4ByteMode = true;
+        }
+    }
+
+    uint16_t instrs[8];
+    uint32_t count = 0;
+    const nor_sfdp_read_mode_t *read = &info->readModes[readMode];
+    uint8_t addrPads = s_flashSfdpReadPads[readMode][0];
+    uint8_t dataPads = s_flashSfdpReadPads[readMode][1];
+    uint32_t modeBits = read->modeClocks << addrPads;
+    uint32_t dummyClocks = read->dummyClocks;
+    uint8_t readOpcode = is4ByteOpcodes ? s_flashSfdpRead4ByteOpcode[readMode] : read->opcode;
+    instrs[count++] = NOR_SFDP_LUT_INSTR(kFLEXSPI_Command_SDR, kFLEXSPI_1PAD, readOpcode);
+    instrs[count++] = NOR_SFDP_LUT_INSTR(kFLEXSPI_Command_RADDR_SDR, addrPads, addrBits);
+    // Mode bits 0x00 keep device out of continuous read mode, odd widths are sent as dummy cycles
+    if ((modeBits == 2) || (modeBits == 4) || (modeBits == 8))
+    {
+        uint8_t modeCmd = (modeBits == 8) ? kFLEXSPI_Command_MODE8_SDR :
+                          ((modeBits == 4) ? kFLEXSPI_Command_MODE4_SDR : kFLEXSPI_Command_MODE2_SDR);
+        instrs[count++] = NOR_SFDP_LUT_INSTR(modeCmd, addrPads, 0x00);
+    }
+    else
+    {
+        dummyClocks += read->modeClocks;
+    }
+    if (dummyClocks)
+    {
+        instrs[count++] = NOR_SFDP_LUT_INSTR(kFLEXSPI_Command_DUMMY_SDR, dataPads, dummyClocks);
+    }
+    instrs[count++] = NOR_SFDP_LUT_INSTR(kFLEXSPI_Command_READ_SDR, dataPads, 0x04);
+    mtu_flash_sfdp_set_seq(lut, NOR_CMD_LUT_SEQ_IDX_READ, instrs, count);
+
+    instrs[0] = NOR_SFDP_LUT_INSTR(kFLEXSPI_Command_SDR, kFLEXSPI_1PAD, 0x05);
+    instrs[1] = NOR_SFDP_LUT_INSTR(kFLEXSPI_Command_READ_SDR, kFLEXSPI_1PAD, 0x04);
+    mtu_flash_sfdp_set_seq(lut, NOR_CMD_LUT_SEQ_IDX_READSTATUS, instrs, 2);
+
+    instrs[0] = NOR_SFDP_LUT_INSTR(kFLEXSPI_Command_SDR, kFLEXSPI_1PAD, 0x9F);
+    instrs[1] = NOR_SFDP_LUT_INSTR(kFLEXSPI_Command_READ_SDR, kFLEXSPI_1PAD, 0x04);
+    mtu_flash_sfdp_set_seq(lut, NOR_CMD_LUT_SEQ_IDX_READID, instrs, 2);
+
+    instrs[0] = NOR_SFDP_LUT_INSTR(kFLEXSPI_Command_SDR, kFLEXSPI_1PAD, 0x06);
+    mtu_flash_sfdp_set_seq(lut, NOR_CMD_LUT_SEQ_IDX_WRITEENABLE, instrs, 1);
+
+    instrs[0] = NOR_SFDP_LUT_INSTR(kFLEXSPI_Command_SDR, kFLEXSPI_1PAD, is4ByteOpcodes ? 0x12 : 0x02);
+    instrs[1] = NOR_SFDP_LUT_INSTR(kFLEXSPI_Command_RADDR_SDR, kFLEXSPI_1PAD, addrBits);
+    instrs[2] = NOR_SFDP_LUT_INSTR(kFLEXSPI_Command_WRITE_SDR, kFLEXSPI_1PAD, 0x04);
+    mtu_flash_sfdp_set_seq(lut, NOR_CMD_LUT_SEQ_IDX_PAGEPROGRAM, instrs, 3);
+
+    if (sectorErase != NULL)
+    {
+        instrs[0] = NOR_SFDP_LUT_INSTR(kFLEXSPI_Command_SDR, kFLEXSPI_1PAD,
+                                       is4ByteOpcodes ? sectorErase->opcode4B : sectorErase->opcode);
+        instrs[1] = NOR_SFDP_LUT_INSTR(kFLEXSPI_Command_RADDR_SDR, kFLEXSPI_1PAD, addrBits);
+        mtu_flash_sfdp_set_seq(lut, NOR_CMD_LUT_SEQ_IDX_ERASESECTOR, instrs, 2);
+        if (sectorErase->typicalUs)
+        {
+            mtu_mixspi_nor_set_poll_timing(kNorOp_EraseSector, sectorErase->typicalUs, sectorErase->timeoutUs);
+        }
+    }
+    else
+    {
+        printf("Flash SFDP has no 4KB erase type, host sector erase sequence is kept.\r\n");
+    }
+    if (info->pageProgramTypicalUs)
+    {
+        mtu_mixspi_nor_set_poll_timing(kNorOp_PageProgram, info->pageProgramTypicalUs, info->pageProgramTimeoutUs);
+    }
+
+    // Without QE requirement in SFDP, QE sequence and config of host stay in use
+    if ((dataPads == kFLEXSPI_4PAD) && (info->quadEnableReq != NOR_SFDP_QE_UNKNOWN))
+    {
+        const nor_sfdp_qe_method_t *qe = &s_flashSfdpQeMethods[info->quadEnableReq];
+        memProperty->flashQuadEnableBytes = qe->bytes;
+        memProperty->flashQuadEnableCfg = qe->value;
+        if (qe->bytes)
+        {
+            instrs[0] = NOR_SFDP_LUT_INSTR(kFLEXSPI_Command_SDR, kFLEXSPI_1PAD, qe->opcode);
+            instrs[1] = NOR_SFDP_LUT_INSTR(kFLEXSPI_Command_WRITE_SDR, kFLEXSPI_1PAD, qe->bytes);
+            mtu_flash_sfdp_set_seq(lut, NOR_CMD_LUT_SEQ_IDX_ENABLEQE, instrs, 2);
+        }
+    }
+    if (!memProperty->flashSizeLog2)
+    {
+        memProperty->flashSizeLog2 = 31 - __CLZ(info->sizeInBytes);
+    }
+
+    FLEXSPI_UpdateLUT(userConfig->mixspiBase, 0, lut, CUSTOM_LUT_LENGTH);
+    // AHB read sequence changed, nothing prefetched with the old one may be kept
+    FLEXSPI_SoftwareReset(userConfig->mixspiBase);
+    if (isEnter4ByteMode)
+    {
+        status = mtu_mixspi_nor_enter_4byte_mode(userConfig);
+        if (status != kStatus_Success)
+        {
+            printf("Flash failed to enter 4-byte address mode.\r\n");
+            return status;
+        }
+    }
+
+    printf("Flash SFDP %d.%d: %dKB, page %dB, read %s %02Xh (dummy %d, mode %d), %d-bit address%s.\r\n",
+           info->majorRev, info->minorRev, info->sizeInBytes / 0x400, info->pageSize, s_flashSfdpReadModeName[readMode],
+           readOpcode, read->dummyClocks, read->modeClocks,
+           addrBits, is4ByteOpcodes ? " (4-byte opcodes)" : (isEnter4ByteMode ? " (4-byte mode)" : ""));
+    for (uint32_t i = 0; i < NOR_SFDP_ERASE_TYPES; i++)
+    {
+        if (info->eraseTypes[i].size)
+        {
+            printf("  Erase type %d: %dKB %02Xh, typical %d us, max %d us\r\n", i + 1,
+                   info->eraseTypes[i].size / 0x400, info->eraseTypes[i].opcode, info->eraseTypes[i].typicalUs,
+                   info->eraseTypes[i].timeoutUs);
+        }
+    }
+    if (info->quadEnableReq != NOR_SFDP_QE_UNKNOWN)
+    {
+        printf("  Quad enable requirement %d, page program typical %d us, max %d us\r\n", info->quadEnableReq,
+               info->pageProgramTypicalUs, info->pageProgramTimeoutUs);
+    }
+    if (info->hasXspiProfile)
+    {
+        printf("  xSPI profile 1.0 table found, octal LUT sequences stay as host provided.\r\n");
+    }
+    if (info->pageSize < MTU_MEM_NOR_PAGE_SIZE)
+    {
+        printf("WARNING: Flash page is smaller than %dB programmed by firmware.\r\n", MTU_MEM_NOR_PAGE_SIZE);
+    }
+
+    return kStatus_Success;
+}
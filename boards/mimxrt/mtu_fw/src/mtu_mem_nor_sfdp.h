@@ -0,0 +1,93 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _MTU_MEM_NOR_SFDP_H_
+#define _MTU_MEM_NOR_SFDP_H_
+
+#include "mtu.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+//! @brief "SFDP" signature of JESD216 header, as read in little endian.
+#define NOR_SFDP_SIGNATURE         (0x50444653UL)
+
+//! @brief Parameter headers looked at, and BFPT dwords kept (JESD216F has 20).
+#define NOR_SFDP_MAX_PARAM_HEADERS (8)
+#define NOR_SFDP_BFPT_MAX_DWORDS   (20)
+#define NOR_SFDP_ERASE_TYPES       (4)
+
+//! @brief Parameter table IDs, MSB << 8 | LSB.
+#define NOR_SFDP_ID_BFPT           (0xFF00)
+#define NOR_SFDP_ID_4BYTE_ADDR     (0xFF84)
+#define NOR_SFDP_ID_XSPI_PROFILE1  (0xFF05)
+
+//! @brief QE requirement (BFPT DW15[22:20]) not known, table is older than JESD216A.
+#define NOR_SFDP_QE_UNKNOWN        (0xFF)
+
+//! @brief Fast read modes of BFPT (command-address-data lines), ordered from slowest to fastest.
+enum _nor_sfdp_read_modes
+{
+    kNorSfdpRead_1_1_1 = 0x00,
+    kNorSfdpRead_1_1_2 = 0x01,
+    kNorSfdpRead_1_2_2 = 0x02,
+    kNorSfdpRead_1_1_4 = 0x03,
+    kNorSfdpRead_1_4_4 = 0x04,
+    kNorSfdpRead_MaxIdx,
+};
+
+typedef struct _nor_sfdp_read_mode
+{
+    uint8_t opcode;
+    uint8_t dummyClocks;
+    uint8_t modeClocks;
+    uint8_t reserved;
+} nor_sfdp_read_mode_t;
+
+//! @brief One erase type of BFPT, size 0 if not supported.
+typedef struct _nor_sfdp_erase_type
+{
+    uint32_t size;
+    uint8_t opcode;
+    uint8_t opcode4B;       // 0: no 4-byte address opcode
+    uint8_t reserved[2];
+    uint32_t typicalUs;     // 0: not given
+    uint32_t timeoutUs;
+} nor_sfdp_erase_type_t;
+
+typedef struct _nor_sfdp_info
+{
+    uint8_t majorRev;
+    uint8_t minorRev;
+    uint8_t addrBytes;          // BFPT DW1[18:17], 0: 3-byte, 1: 3 or 4-byte, 2: 4-byte only
+    uint8_t quadEnableReq;      // BFPT DW15[22:20]
+    uint8_t enter4ByteMethods;  // BFPT DW16[31:24]
+    bool hasXspiProfile;
+    bool hasSuspend;            // BFPT DW12[31] clear
+    uint8_t suspendOpcode;      // BFPT DW13[31:24], erase suspend
+    uint8_t resumeOpcode;       // BFPT DW13[23:16], erase resume
+    uint8_t reserved[3];
+    uint32_t sizeInBytes;
+    uint32_t pageSize;
+    uint32_t pageProgramTypicalUs;
+    uint32_t pageProgramTimeoutUs;
+    uint32_t readModeMap;       // Bit per read mode
+    nor_sfdp_read_mode_t readModes[kNorSfdpRead_MaxIdx];
+    nor_sfdp_erase_type_t eraseTypes[NOR_SFDP_ERASE_TYPES];
+    uint32_t instr4ByteMap;     // 4-byte address instruction table DW1, 0 if no table
+} nor_sfdp_info_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+status_t mtu_flash_sfdp_read(mixspi_user_config_t *userConfig, nor_sfdp_info_t *info);
+
+status_t mtu_flash_sfdp_configure(mixspi_user_config_t *userConfig, uint32_t *lut);
+
+#endif /* _MTU_MEM_NOR_SFDP_H_ */
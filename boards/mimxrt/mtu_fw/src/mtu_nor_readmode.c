@@ -0,0 +1,231 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "mtu.h"
+#include "fsl_cache.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+//! @brief Result of one read mode.
+typedef struct _nor_readmode_result
+{
+    uint64_t readCycles;
+    uint32_t bytes;
+    bool isTried;
+    bool isCorrect;
+} nor_readmode_result_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+static void mtu_nor_readmode_build_seq(uint32_t *seq, const nor_read_mode_t *mode, uint8_t addrBits,
+                                       bool is4ByteOpcodes);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+//! @brief Candidates from slowest to fastest, dummy variants cover common vendor defaults.
+static const nor_read_mode_t s_norReadModes[] = {
+    {"03h 1-1-1", 0x03, kFLEXSPI_1PAD, kFLEXSPI_1PAD, 0, 0, kNorSfdpRead_MaxIdx},
+    {"0Bh 1-1-1", 0x0B, kFLEXSPI_1PAD, kFLEXSPI_1PAD, 0, 8, kNorSfdpRead_MaxIdx},
+    {"3Bh 1-1-2", 0x3B, kFLEXSPI_1PAD, kFLEXSPI_2PAD, 0, 8, kNorSfdpRead_1_1_2},
+    {"BBh 1-2-2", 0xBB, kFLEXSPI_2PAD, kFLEXSPI_2PAD, 4, 0, kNorSfdpRead_1_2_2},
+    {"BBh 1-2-2", 0xBB, kFLEXSPI_2PAD, kFLEXSPI_2PAD, 4, 4, kNorSfdpRead_1_2_2},
+    {"6Bh 1-1-4", 0x6B, kFLEXSPI_1PAD, kFLEXSPI_4PAD, 0, 8, kNorSfdpRead_1_1_4},
+    {"EBh 1-4-4", 0xEB, kFLEXSPI_4PAD, kFLEXSPI_4PAD, 2, 4, kNorSfdpRead_1_4_4},
+    {"EBh 1-4-4", 0xEB, kFLEXSPI_4PAD, kFLEXSPI_4PAD, 2, 6, kNorSfdpRead_1_4_4},
+    {"EBh 1-4-4", 0xEB, kFLEXSPI_4PAD, kFLEXSPI_4PAD, 2, 8, kNorSfdpRead_1_4_4},
+};
+
+//! @brief Host read sequence is entry 0, it covers QPI/OPI STR/DTR modes configured by host.
+static nor_readmode_result_t s_norReadModeResult[ARRAY_SIZE(s_norReadModes) + 1];
+
+static nor_sfdp_info_t s_norReadModeSfdp;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static void mtu_nor_readmode_build_seq(uint32_t *seq, const nor_read_mode_t *mode, uint8_t addrBits,
+                                       bool is4ByteOpcodes)
+{
+    uint16_t instrs[8];
+    uint32_t count = 0;
+    uint8_t opcode = mode->opcode;
+    if (is4ByteOpcodes)
+    {
+        opcode = (uint8_t)mtu_mixspi_nor_find_4byte_opcode(opcode);
+    }
+    instrs[count++] = (uint16_t)FLEXSPI_LUT_SEQ(kFLEXSPI_Command_SDR, kFLEXSPI_1PAD, opcode, 0, 0, 0);
+    instrs[count++] = (uint16_t)FLEXSPI_LUT_SEQ(kFLEXSPI_Command_RADDR_SDR, mode->addrPads, addrBits, 0, 0, 0);
+    if (mode->modeClocks)
+    {
+        // All candidates carry 8 mode bits
+        instrs[count++] = (uint16_t)FLEXSPI_LUT_SEQ(kFLEXSPI_Command_MODE8_SDR, mode->addrPads, 0x00, 0, 0, 0);
+    }
+    if (mode->dummyClocks)
+    {
+        instrs[count++] =
+            (uint16_t)FLEXSPI_LUT_SEQ(kFLEXSPI_Command_DUMMY_SDR, mode->dataPads, mode->dummyClocks, 0, 0, 0);
+    }
+    instrs[count++] = (uint16_t)FLEXSPI_LUT_SEQ(kFLEXSPI_Command_READ_SDR, mode->dataPads, 0x04, 0, 0, 0);
+
+    memset(seq, 0, 16);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        seq[i / 2] |= (uint32_t)instrs[i] << ((i & 1) * 16);
+    }
+}
+
+status_t mtu_nor_readmode_run(uint32_t rounds, uint32_t memStart, uint32_t memSize)
+{
+    printf("Arg List: rounds=%d, memStart=0x%x, memSize=0x%x.\n", rounds, memStart, memSize);
+
+    if (s_configSystemPacket.memProperty.type > kMemType_FlashMaxIdx)
+    {
+        printf("Read mode sweep only runs on NOR Flash.\r\n");
+        return kStatus_InvalidArgument;
+    }
+    uint32_t offsetAddr = mtu_memory_convert_to_offset_addr(memStart);
+    if ((offsetAddr & (MTU_MEM_NOR_SECTOR_SIZE - 1)) || (memSize < MTU_MEM_NOR_SECTOR_SIZE))
+    {
+        printf("Test memory region must be aligned with flash sector and contain one sector at least.\r\n");
+        return kStatus_InvalidArgument;
+    }
+    if (!rounds)
+    {
+        rounds = 1;
+    }
+    uint32_t size = (memSize > MTU_NOR_READMODE_MAX_SIZE) ? MTU_NOR_READMODE_MAX_SIZE : memSize;
+    size &= ~(MTU_MEM_NOR_SECTOR_SIZE - 1);
+    uint32_t ambaAddr = offsetAddr + bsp_mixspi_get_amba_base(&s_userConfig);
+
+    // Known pattern, so a wrong dummy count cannot pass on erased or uniform data
+    if (mtu_memory_program_nor_pattern(offsetAddr, size) != kStatus_Success)
+    {
+        return kStatus_Fail;
+    }
+
+    // Candidates are 1-pad SDR commands, device in QPI/OPI or DDR command mode of host does not decode them
+    uint16_t hostCmd = NOR_LUT_INSTR(s_customLUTCommonMode, NOR_CMD_LUT_SEQ_IDX_READ * 8);
+    bool isHostSpiSdr = (NOR_LUT_INSTR_OPCODE(hostCmd) == kFLEXSPI_Command_SDR) &&
+                        (NOR_LUT_INSTR_PADS(hostCmd) == kFLEXSPI_1PAD);
+    // Candidates follow host address width, with 4-byte opcodes if host uses them
+    uint8_t hostOpcode;
+    mtu_mixspi_nor_get_read_cycles(s_customLUTCommonMode, &hostOpcode);
+    uint8_t addrBits = (s_nordeviceconfig.flashSize * 0x400UL > MTU_MEM_NOR_3B_ADDR_MAX_SIZE) ? 32 : 24;
+    bool is4ByteOpcodes = (addrBits == 32) && (hostOpcode != 0) &&
+                          (mtu_mixspi_nor_find_4byte_opcode(hostOpcode) < 0);
+    // Quad lines are usable only if init enabled quad mode, unsupported modes are skipped if SFDP tells
+    bool isQuadAllowed = (s_configSystemPacket.memProperty.type == kMemType_QuadSPI);
+    bool hasSfdp = isHostSpiSdr &&
+                   (mtu_flash_sfdp_read(&s_userConfig, &s_norReadModeSfdp) == kStatus_Success);
+    if (!isHostSpiSdr)
+    {
+        printf("Host read command is not 1-pad SDR, only host LUT is measured.\r\n");
+    }
+    uint32_t hostSeq[4];
+    memcpy(hostSeq, &s_customLUTCommonMode[4 * NOR_CMD_LUT_SEQ_IDX_READ], sizeof(hostSeq));
+
+    memset(s_norReadModeResult, 0, sizeof(s_norReadModeResult));
+    mtu_perf_timebase_start();
+    for (uint32_t idx = 0; idx < ARRAY_SIZE(s_norReadModeResult); idx++)
+    {
+        nor_readmode_result_t *result = &s_norReadModeResult[idx];
+        uint32_t seq[4];
+        if (idx == 0)
+        {
+            memcpy(seq, hostSeq, sizeof(seq));
+        }
+        else
+        {
+            const nor_read_mode_t *mode = &s_norReadModes[idx - 1];
+            if ((!isHostSpiSdr) ||
+                (!isQuadAllowed && ((mode->addrPads == kFLEXSPI_4PAD) || (mode->dataPads == kFLEXSPI_4PAD))) ||
+                (hasSfdp && (mode->sfdpMode < kNorSfdpRead_MaxIdx) &&
+                 !(s_norReadModeSfdp.readModeMap & (1UL << mode->sfdpMode))) ||
+                (is4ByteOpcodes && (mtu_mixspi_nor_find_4byte_opcode(mode->opcode) < 0)))
+            {
+                continue;
+            }
+            mtu_nor_readmode_build_seq(seq, mode, addrBits, is4ByteOpcodes);
+        }
+        mtu_mixspi_nor_set_read_seq(&s_userConfig, s_customLUTCommonMode, seq);
+
+        result->isTried = true;
+        result->isCorrect = true;
+        for (uint32_t round = 0; round < rounds; round++)
+        {
+#if defined(MTU_CACHE_MAINTAIN) && MTU_CACHE_MAINTAIN
+            // Every pass must be served by FlexSPI with the sequence under test
+            DCACHE_InvalidateByRange(ambaAddr, size);
+#endif
+            uint32_t cycles = mtu_cycle_timer_count();
+            uint32_t errors = mtu_memory_verify_pattern(ambaAddr, size, 0);
+            result->readCycles += mtu_cycle_timer_count() - cycles;
+            result->bytes += size;
+            if (errors)
+            {
+                result->isCorrect = false;
+            }
+        }
+    }
+    mtu_mixspi_nor_set_read_seq(&s_userConfig, s_customLUTCommonMode, hostSeq);
+    float cyclesPerUs = (float)mtu_cycle_timer_clocks_per_sec() / 1000000;
+    mtu_perf_timebase_stop();
+
+    uint32_t bestIdx = 0;
+    float bestMBps = 0;
+    printf("%-12s %8s %10s %8s\r\n", "Read mode", "Cycles", "MB/s", "Data");
+    for (uint32_t idx = 0; idx < ARRAY_SIZE(s_norReadModeResult); idx++)
+    {
+        nor_readmode_result_t *result = &s_norReadModeResult[idx];
+        if (!result->isTried)
+        {
+            continue;
+        }
+        float mbps = (float)result->bytes / ((float)result->readCycles / cyclesPerUs);
+        if (idx == 0)
+        {
+            printf("%-12s %8s %10.2f %8s\r\n", "Host LUT", "-", mbps, result->isCorrect ? "ok" : "ERROR");
+        }
+        else
+        {
+            const nor_read_mode_t *mode = &s_norReadModes[idx - 1];
+            printf("%-12s %8d %10.2f %8s\r\n", mode->name, mode->modeClocks + mode->dummyClocks, mbps,
+                   result->isCorrect ? "ok" : "ERROR");
+        }
+        if (result->isCorrect && (mbps > bestMBps))
+        {
+            bestMBps = mbps;
+            bestIdx = idx;
+        }
+    }
+    printf("0x%x bytes per pass, %d passes, FlexSPI root clock %dMHz.\r\n", size, rounds,
+           g_mixspiRootClkFreqInMHz[s_userConfig.mixspiRootClkFreq]);
+    if (bestMBps == 0)
+    {
+        printf("No read mode returned correct data.\r\n");
+        printf("Done and Failed!\r\n");
+        return kStatus_Fail;
+    }
+    printf("Fastest correct mode: %s, %.2f MB/s.\r\n", bestIdx ? s_norReadModes[bestIdx - 1].name : "Host LUT",
+           bestMBps);
+    if (!s_norReadModeResult[0].isCorrect)
+    {
+        printf("Host read sequence returned wrong data.\r\n");
+        printf("Done and Failed!\r\n");
+        return kStatus_Fail;
+    }
+
+    printf("Done and Passed!\r\n");
+    return kStatus_Success;
+}
@@ -0,0 +1,40 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _MTU_NOR_READMODE_H_
+#define _MTU_NOR_READMODE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "fsl_common.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+//! @brief Region programmed with known pattern and streamed over AHB in every read mode.
+#define MTU_NOR_READMODE_MAX_SIZE (0x10000)
+
+//! @brief One read command candidate, mode bits are sent as 0x00 over address pads.
+typedef struct _nor_read_mode
+{
+    const char *name;
+    uint8_t opcode;
+    uint8_t addrPads;
+    uint8_t dataPads;
+    uint8_t modeClocks;
+    uint8_t dummyClocks;
+    uint8_t sfdpMode;    // Read mode bit checked in SFDP, kNorSfdpRead_MaxIdx: always tried
+} nor_read_mode_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+status_t mtu_nor_readmode_run(uint32_t rounds, uint32_t memStart, uint32_t memSize);
+
+#endif /* _MTU_NOR_READMODE_H_ */
@@ -0,0 +1,333 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "mtu.h"
+#include "fsl_cache.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+//! @brief Endurance and timing record of one sector.
+typedef struct _nor_stress_sector
+{
+    uint32_t erases;
+    uint32_t eraseFirstUs;
+    uint32_t eraseLastUs;
+    uint32_t eraseMaxUs;
+    uint64_t eraseSumUs;
+    uint64_t programSumUs;
+    uint32_t programs;
+    uint32_t programMaxUs;
+    uint32_t eraseBitErrors;     // Bits still programmed after erase
+    uint32_t programBitErrors;   // Bits different from pattern after program
+    uint32_t failedCycles;
+    uint32_t reserved0;
+} nor_stress_sector_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+static uint32_t mtu_nor_stress_bit_count(uint32_t value);
+
+static uint32_t mtu_nor_stress_pattern_word(uint8_t pattern, uint32_t wordOffset);
+
+static uint32_t mtu_nor_stress_elapsed_us(uint64_t startTime);
+
+static void mtu_nor_stress_hist_add(uint32_t *hist, uint32_t us);
+
+static void mtu_nor_stress_hist_print(const char *name, const uint32_t *hist);
+
+static status_t mtu_nor_stress_cycle_sector(nor_stress_sector_t *sector, uint32_t offsetAddr, uint32_t ambaAddr,
+                                            uint8_t pattern);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static nor_stress_sector_t s_norStressSector[MTU_NOR_STRESS_MAX_SECTORS];
+
+static uint32_t s_norStressEraseHist[MTU_NOR_STRESS_HIST_BUCKETS];
+static uint32_t s_norStressProgramHist[MTU_NOR_STRESS_HIST_BUCKETS];
+
+//! @brief Source of page program, it must be in RAM while flash is busy.
+static uint32_t s_norStressPageBuffer[MTU_MEM_NOR_PAGE_SIZE / 4];
+
+static const char *const s_norStressPatternName[kNorStressPattern_MaxIdx] = {"all 0s", "0x55AA55AA", "0xAA55AA55",
+                                                                             "address"};
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static uint32_t mtu_nor_stress_bit_count(uint32_t value)
+{
+    uint32_t count = 0;
+    while (value)
+    {
+        value &= value - 1;
+        count++;
+    }
+
+    return count;
+}
+
+static uint32_t mtu_nor_stress_pattern_word(uint8_t pattern, uint32_t wordOffset)
+{
+    switch (pattern)
+    {
+        case kNorStressPattern_AllZeros:
+            return 0;
+        case kNorStressPattern_Checkerboard:
+            return 0x55AA55AAUL;
+        case kNorStressPattern_InvCheckerboard:
+            return 0xAA55AA55UL;
+        default:
+            return wordOffset;
+    }
+}
+
+static uint32_t mtu_nor_stress_elapsed_us(uint64_t startTime)
+{
+    return (uint32_t)((mtu_cycle_timer_clock() - startTime) * 1000000 / mtu_cycle_timer_clocks_per_sec());
+}
+
+static void mtu_nor_stress_hist_add(uint32_t *hist, uint32_t us)
+{
+    uint32_t bucket = us ? (31 - __CLZ(us)) : 0;
+    if (bucket >= MTU_NOR_STRESS_HIST_BUCKETS)
+    {
+        bucket = MTU_NOR_STRESS_HIST_BUCKETS - 1;
+    }
+    hist[bucket]++;
+}
+
+static void mtu_nor_stress_hist_print(const char *name, const uint32_t *hist)
+{
+    printf("%s time histogram:\r\n", name);
+    for (uint32_t bucket = 0; bucket < MTU_NOR_STRESS_HIST_BUCKETS; bucket++)
+    {
+        if (!hist[bucket])
+        {
+            continue;
+        }
+        if (bucket == MTU_NOR_STRESS_HIST_BUCKETS - 1)
+        {
+            printf("  [%8d,      inf) us: %d\r\n", 1UL << bucket, hist[bucket]);
+        }
+        else
+        {
+            printf("  [%8d, %8d) us: %d\r\n", 1UL << bucket, 2UL << bucket, hist[bucket]);
+        }
+    }
+}
+
+static status_t mtu_nor_stress_cycle_sector(nor_stress_sector_t *sector, uint32_t offsetAddr, uint32_t ambaAddr,
+                                            uint8_t pattern)
+{
+    bool isFailed = false;
+
+    // Erase, then every bit must read back as 1
+    uint64_t startTime = mtu_cycle_timer_clock();
+    status_t status = mtu_mixspi_nor_erase_sector(&s_userConfig, offsetAddr, kFlashInstMode_SPI);
+    uint32_t us = mtu_nor_stress_elapsed_us(startTime);
+    if (status != kStatus_Success)
+    {
+        printf("Erase flash sector failure at address 0x%x!\r\n", offsetAddr);
+        return kStatus_Fail;
+    }
+    if (!sector->erases)
+    {
+        sector->eraseFirstUs = us;
+    }
+    sector->erases++;
+    sector->eraseLastUs = us;
+    sector->eraseSumUs += us;
+    if (us > sector->eraseMaxUs)
+    {
+        sector->eraseMaxUs = us;
+    }
+    mtu_nor_stress_hist_add(s_norStressEraseHist, us);
+
+#if defined(MTU_CACHE_MAINTAIN) && MTU_CACHE_MAINTAIN
+    DCACHE_InvalidateByRange(ambaAddr, MTU_MEM_NOR_SECTOR_SIZE);
+#endif
+    for (uint32_t offset = 0; offset < MTU_MEM_NOR_SECTOR_SIZE; offset += 4)
+    {
+        uint32_t errors = mtu_nor_stress_bit_count(~*(volatile uint32_t *)(ambaAddr + offset));
+        if (errors)
+        {
+            sector->eraseBitErrors += errors;
+            isFailed = true;
+        }
+    }
+
+    // Program all pages with pattern, then read back
+    for (uint32_t pageOffset = 0; pageOffset < MTU_MEM_NOR_SECTOR_SIZE; pageOffset += MTU_MEM_NOR_PAGE_SIZE)
+    {
+        for (uint32_t i = 0; i < ARRAY_SIZE(s_norStressPageBuffer); i++)
+        {
+            s_norStressPageBuffer[i] = mtu_nor_stress_pattern_word(pattern, (offsetAddr + pageOffset) / 4 + i);
+        }
+        startTime = mtu_cycle_timer_clock();
+        status = mtu_mixspi_nor_page_program(&s_userConfig, &s_nordeviceconfig, offsetAddr + pageOffset,
+                                             (const uint32_t *)s_norStressPageBuffer, MTU_MEM_NOR_PAGE_SIZE,
+                                             kFlashInstMode_SPI);
+        us = mtu_nor_stress_elapsed_us(startTime);
+        if (status != kStatus_Success)
+        {
+            printf("Program flash page failure at address 0x%x!\r\n", offsetAddr + pageOffset);
+            return kStatus_Fail;
+        }
+        sector->programs++;
+        sector->programSumUs += us;
+        if (us > sector->programMaxUs)
+        {
+            sector->programMaxUs = us;
+        }
+        mtu_nor_stress_hist_add(s_norStressProgramHist, us);
+    }
+
+#if defined(MTU_CACHE_MAINTAIN) && MTU_CACHE_MAINTAIN
+    DCACHE_InvalidateByRange(ambaAddr, MTU_MEM_NOR_SECTOR_SIZE);
+#endif
+    for (uint32_t offset = 0; offset < MTU_MEM_NOR_SECTOR_SIZE; offset += 4)
+    {
+        uint32_t expected = mtu_nor_stress_pattern_word(pattern, (offsetAddr + offset) / 4);
+        uint32_t errors = mtu_nor_stress_bit_count(*(volatile uint32_t *)(ambaAddr + offset) ^ expected);
+        if (errors)
+        {
+            sector->programBitErrors += errors;
+            isFailed = true;
+        }
+    }
+
+    if (isFailed)
+    {
+        sector->failedCycles++;
+        return kStatus_Fail;
+    }
+
+    return kStatus_Success;
+}
+
+status_t mtu_nor_stress_run(uint32_t cycles, bool stopWhenFail, uint32_t memStart, uint32_t memSize)
+{
+    printf("Arg List: cycles=%d, fail_stop=%d, memStart=0x%x, memSize=0x%x.\n", cycles, stopWhenFail, memStart, memSize);
+
+    if (s_configSystemPacket.memProperty.type > kMemType_FlashMaxIdx)
+    {
+        printf("NOR stress test only runs on NOR Flash, use memtester for RAM.\r\n");
+        return kStatus_InvalidArgument;
+    }
+    uint32_t offsetAddr = mtu_memory_convert_to_offset_addr(memStart);
+    if ((offsetAddr & (MTU_MEM_NOR_SECTOR_SIZE - 1)) || (memSize < MTU_MEM_NOR_SECTOR_SIZE))
+    {
+        printf("Test memory region must be aligned with flash sector and contain one sector at least.\r\n");
+        return kStatus_InvalidArgument;
+    }
+    uint32_t sectorCount = memSize / MTU_MEM_NOR_SECTOR_SIZE;
+    if (sectorCount > MTU_NOR_STRESS_MAX_SECTORS)
+    {
+        printf("Only first %d sectors are tested.\r\n", MTU_NOR_STRESS_MAX_SECTORS);
+        sectorCount = MTU_NOR_STRESS_MAX_SECTORS;
+    }
+    if (!cycles)
+    {
+        cycles = 1;
+    }
+    uint32_t ambaAddr = offsetAddr + bsp_mixspi_get_amba_base(&s_userConfig);
+
+    memset(s_norStressSector, 0, sizeof(s_norStressSector));
+    memset(s_norStressEraseHist, 0, sizeof(s_norStressEraseHist));
+    memset(s_norStressProgramHist, 0, sizeof(s_norStressProgramHist));
+    uint32_t failedCycles = 0;
+    mtu_perf_timebase_start();
+    // tSE/tPP are reported per sector, they must not carry the back-off of busy polling
+    mtu_mixspi_nor_set_poll_precise(true);
+    for (uint32_t cycle = 1; cycle <= cycles; cycle++)
+    {
+        uint8_t pattern = (cycle - 1) % kNorStressPattern_MaxIdx;
+        bool isFailed = false;
+        for (uint32_t sectorIdx = 0; sectorIdx < sectorCount; sectorIdx++)
+        {
+            uint32_t sectorOffset = sectorIdx * MTU_MEM_NOR_SECTOR_SIZE;
+            nor_stress_sector_t *sector = &s_norStressSector[sectorIdx];
+            uint32_t bitErrors = sector->eraseBitErrors + sector->programBitErrors;
+            status_t status = mtu_nor_stress_cycle_sector(sector, offsetAddr + sectorOffset, ambaAddr + sectorOffset,
+                                                          pattern);
+            if (status != kStatus_Success)
+            {
+                printf("FAILURE: cycle %d sector 0x%x, %d bit errors.\r\n", cycle, offsetAddr + sectorOffset,
+                       sector->eraseBitErrors + sector->programBitErrors - bitErrors);
+                isFailed = true;
+                if (stopWhenFail)
+                {
+                    break;
+                }
+            }
+        }
+        printf("Cycle %d/%d (%s): %s\r\n", cycle, cycles, s_norStressPatternName[pattern], isFailed ? "failed" : "ok");
+        if (isFailed)
+        {
+            failedCycles++;
+            if (stopWhenFail)
+            {
+                break;
+            }
+        }
+    }
+    mtu_mixspi_nor_set_poll_precise(false);
+    mtu_perf_timebase_stop();
+
+    // Average erase time of all sectors is the reference of slow-erase detection
+    uint64_t eraseSumUs = 0;
+    uint32_t erases = 0;
+    for (uint32_t sectorIdx = 0; sectorIdx < sectorCount; sectorIdx++)
+    {
+        eraseSumUs += s_norStressSector[sectorIdx].eraseSumUs;
+        erases += s_norStressSector[sectorIdx].erases;
+    }
+    uint32_t eraseAvgUs = erases ? (uint32_t)(eraseSumUs / erases) : 0;
+    uint32_t slowSectors = 0;
+
+    printf("%-10s %8s %10s %10s %10s %10s %10s %8s %8s  %s\r\n", "Sector", "Erases", "tSE avg", "tSE max",
+           "tSE first", "tSE last", "tPP avg", "ErsBits", "PgmBits", "Flag");
+    for (uint32_t sectorIdx = 0; sectorIdx < sectorCount; sectorIdx++)
+    {
+        nor_stress_sector_t *sector = &s_norStressSector[sectorIdx];
+        if (!sector->erases)
+        {
+            continue;
+        }
+        uint32_t sectorEraseAvgUs = (uint32_t)(sector->eraseSumUs / sector->erases);
+        bool isSlow = ((uint64_t)sectorEraseAvgUs * 100 > (uint64_t)eraseAvgUs * (100 + MTU_NOR_STRESS_SLOW_ERASE_PERCENT));
+        if (isSlow)
+        {
+            slowSectors++;
+        }
+        printf("0x%08x %8d %10d %10d %10d %10d %10d %8d %8d  %s%s\r\n", offsetAddr + sectorIdx * MTU_MEM_NOR_SECTOR_SIZE,
+               sector->erases, sectorEraseAvgUs, sector->eraseMaxUs, sector->eraseFirstUs, sector->eraseLastUs,
+               sector->programs ? (uint32_t)(sector->programSumUs / sector->programs) : 0, sector->eraseBitErrors,
+               sector->programBitErrors, isSlow ? "slow " : "", sector->failedCycles ? "failed" : "");
+    }
+    printf("Times are in us, tPP is per 0x%x bytes page. Average tSE %d us, %d slow-erase sectors (> %d%% above).\r\n",
+           MTU_MEM_NOR_PAGE_SIZE, eraseAvgUs, slowSectors, MTU_NOR_STRESS_SLOW_ERASE_PERCENT);
+    mtu_nor_stress_hist_print("Sector erase", s_norStressEraseHist);
+    mtu_nor_stress_hist_print("Page program", s_norStressProgramHist);
+
+    if (failedCycles)
+    {
+        printf("%d cycles failed.\r\n", failedCycles);
+        printf("Done and Failed!\r\n");
+        return kStatus_Fail;
+    }
+
+    printf("Done and Passed!\r\n");
+    return kStatus_Success;
+}
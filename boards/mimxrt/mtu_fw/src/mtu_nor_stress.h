@@ -0,0 +1,44 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _MTU_NOR_STRESS_H_
+#define _MTU_NOR_STRESS_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "fsl_common.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+//! @brief Sectors tracked individually, test region is limited to this many sectors.
+#define MTU_NOR_STRESS_MAX_SECTORS        (64)
+
+//! @brief Erase/program time histograms have log2 buckets of microseconds, last one collects all above.
+#define MTU_NOR_STRESS_HIST_BUCKETS       (20)
+
+//! @brief A sector is slow if its average erase time exceeds the average of all sectors by this percent.
+#define MTU_NOR_STRESS_SLOW_ERASE_PERCENT (50)
+
+//! @brief Program patterns, rotated by cycle so every cell sees both states.
+enum _nor_stress_patterns
+{
+    kNorStressPattern_AllZeros        = 0x00,    // Every bit programmed
+    kNorStressPattern_Checkerboard    = 0x01,    // 0x55AA55AA
+    kNorStressPattern_InvCheckerboard = 0x02,    // 0xAA55AA55
+    kNorStressPattern_Address         = 0x03,    // Word offset as data, catches address faults
+    kNorStressPattern_MaxIdx,
+};
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+status_t mtu_nor_stress_run(uint32_t cycles, bool stopWhenFail, uint32_t memStart, uint32_t memSize);
+
+#endif /* _MTU_NOR_STRESS_H_ */
@@ -0,0 +1,277 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "mtu.h"
+#include "fsl_cache.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+//! @brief Min/max/sum of one latency, in CPU cycles.
+typedef struct _nor_suspend_stat
+{
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+} nor_suspend_stat_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+static void mtu_nor_suspend_stat_add(uint8_t metric, uint32_t cycles);
+
+static uint32_t mtu_nor_suspend_read(uint32_t ambaAddr, uint32_t readSize, uint32_t *firstReadCycles);
+
+static bool mtu_nor_suspend_is_erased(uint32_t ambaAddr);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static nor_suspend_stat_t s_norSuspendStat[kNorSuspendMetric_MaxIdx];
+
+static const char *const s_norSuspendMetricName[kNorSuspendMetric_MaxIdx] = {
+    "Suspend latency", "First read", "Read region", "Resume", "XIP stall", "Erase total"};
+
+static nor_sfdp_info_t s_norSuspendSfdp;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static void mtu_nor_suspend_stat_add(uint8_t metric, uint32_t cycles)
+{
+    nor_suspend_stat_t *stat = &s_norSuspendStat[metric];
+    if (cycles < stat->min)
+    {
+        stat->min = cycles;
+    }
+    if (cycles > stat->max)
+    {
+        stat->max = cycles;
+    }
+    stat->sum += cycles;
+}
+
+static uint32_t mtu_nor_suspend_read(uint32_t ambaAddr, uint32_t readSize, uint32_t *firstReadCycles)
+{
+#if defined(MTU_CACHE_MAINTAIN) && MTU_CACHE_MAINTAIN
+    // Reads must reach the device, as a cache miss of XIP consumer does
+    DCACHE_InvalidateByRange(ambaAddr, readSize);
+#endif
+    uint32_t cycles = mtu_cycle_timer_count();
+    uint32_t checksum = *(volatile uint32_t *)ambaAddr;
+    *firstReadCycles = mtu_cycle_timer_count() - cycles;
+    for (uint32_t offset = 4; offset < readSize; offset += 4)
+    {
+        checksum ^= *(volatile uint32_t *)(ambaAddr + offset) + offset;
+    }
+
+    return checksum;
+}
+
+static bool mtu_nor_suspend_is_erased(uint32_t ambaAddr)
+{
+#if defined(MTU_CACHE_MAINTAIN) && MTU_CACHE_MAINTAIN
+    DCACHE_InvalidateByRange(ambaAddr, MTU_MEM_NOR_SECTOR_SIZE);
+#endif
+    for (uint32_t offset = 0; offset < MTU_MEM_NOR_SECTOR_SIZE; offset += 4)
+    {
+        if (*(volatile uint32_t *)(ambaAddr + offset) != 0xFFFFFFFFUL)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+status_t mtu_nor_suspend_run(uint32_t rounds, uint32_t suspendDelayUs, uint32_t memStart, uint32_t memSize)
+{
+    printf("Arg List: rounds=%d, suspendDelayUs=%d, memStart=0x%x, memSize=0x%x.\n", rounds, suspendDelayUs, memStart,
+           memSize);
+
+    if (s_configSystemPacket.memProperty.type > kMemType_FlashMaxIdx)
+    {
+        printf("Erase suspend test only runs on NOR Flash.\r\n");
+        return kStatus_InvalidArgument;
+    }
+    if (s_configSystemPacket.memProperty.type == kMemType_HyperFlash)
+    {
+        printf("Erase suspend is only supported with SPI commands.\r\n");
+        return kStatus_InvalidArgument;
+    }
+    uint32_t offsetAddr = mtu_memory_convert_to_offset_addr(memStart);
+    if ((offsetAddr & (MTU_MEM_NOR_SECTOR_SIZE - 1)) || (memSize < 2 * MTU_MEM_NOR_SECTOR_SIZE))
+    {
+        printf("Test memory region must be aligned with flash sector and contain two sectors at least.\r\n");
+        return kStatus_InvalidArgument;
+    }
+    if (!rounds)
+    {
+        rounds = 1;
+    }
+    // Suspend/resume opcodes are vendor specific (75h/7Ah, B0h/30h), SFDP is read in 1-pad SDR only
+    uint16_t hostCmd = NOR_LUT_INSTR(s_userConfig.mixspiCustomLUTVendor, NOR_CMD_LUT_SEQ_IDX_WRITEENABLE * 8);
+    bool hasSfdp = (NOR_LUT_INSTR_OPCODE(hostCmd) == kFLEXSPI_Command_SDR) &&
+                   (NOR_LUT_INSTR_PADS(hostCmd) == kFLEXSPI_1PAD) &&
+                   (mtu_flash_sfdp_read(&s_userConfig, &s_norSuspendSfdp) == kStatus_Success);
+    if (hasSfdp && (s_norSuspendSfdp.suspendOpcode != 0))
+    {
+        if (!s_norSuspendSfdp.hasSuspend)
+        {
+            printf("SFDP of device reports no erase suspend support.\r\n");
+            return kStatus_InvalidArgument;
+        }
+        mtu_mixspi_nor_set_suspend_opcodes(s_norSuspendSfdp.suspendOpcode, s_norSuspendSfdp.resumeOpcode);
+        printf("Suspend/resume opcodes from SFDP: 0x%x/0x%x\r\n", s_norSuspendSfdp.suspendOpcode,
+               s_norSuspendSfdp.resumeOpcode);
+    }
+    else
+    {
+        mtu_mixspi_nor_set_suspend_opcodes(NOR_SUSPEND_OPCODE, NOR_RESUME_OPCODE);
+        printf("No SFDP suspend opcodes, default 0x%x/0x%x is used\r\n", NOR_SUSPEND_OPCODE, NOR_RESUME_OPCODE);
+    }
+    // First sector is erased, the rest is read while erase is suspended
+    uint32_t readSize = memSize - MTU_MEM_NOR_SECTOR_SIZE;
+    if (readSize > MTU_NOR_SUSPEND_MAX_READ_SIZE)
+    {
+        readSize = MTU_NOR_SUSPEND_MAX_READ_SIZE;
+    }
+    uint32_t ambaAddr = offsetAddr + bsp_mixspi_get_amba_base(&s_userConfig);
+    uint32_t readAddr = ambaAddr + MTU_MEM_NOR_SECTOR_SIZE;
+
+    for (uint32_t metric = 0; metric < kNorSuspendMetric_MaxIdx; metric++)
+    {
+        s_norSuspendStat[metric].min = 0xFFFFFFFFUL;
+        s_norSuspendStat[metric].max = 0;
+        s_norSuspendStat[metric].sum = 0;
+    }
+    uint32_t passedRounds = 0;
+    uint32_t failedRounds = 0;
+    uint32_t finishedRounds = 0;
+    uint32_t polls;
+    mtu_perf_timebase_start();
+    float cyclesPerUs = (float)mtu_cycle_timer_clocks_per_sec() / 1000000;
+    uint64_t delayCycles = (uint64_t)suspendDelayUs * mtu_cycle_timer_clocks_per_sec() / 1000000;
+
+    // Baseline of idle device, also the reference data of reads while suspended
+    uint32_t idleFirstReadCycles;
+    uint32_t readCycles = mtu_cycle_timer_count();
+    uint32_t idleChecksum = mtu_nor_suspend_read(readAddr, readSize, &idleFirstReadCycles);
+    readCycles = mtu_cycle_timer_count() - readCycles;
+    printf("Idle read: first word %.2f us, 0x%x bytes %.2f us\r\n", (float)idleFirstReadCycles / cyclesPerUs, readSize,
+           (float)readCycles / cyclesPerUs);
+
+    for (uint32_t round = 1; round <= rounds; round++)
+    {
+        uint32_t firstReadCycles;
+        uint64_t eraseTime = mtu_cycle_timer_clock();
+        status_t status = mtu_mixspi_nor_erase_sector_start(&s_userConfig, offsetAddr, kFlashInstMode_SPI);
+        if (status != kStatus_Success)
+        {
+            printf("Erase flash sector failure at address 0x%x!\r\n", offsetAddr);
+            failedRounds++;
+            break;
+        }
+        while (mtu_cycle_timer_clock() - eraseTime < delayCycles)
+        {
+        }
+
+        // Erase done before suspend point measures nothing of suspend, so the round is not counted as a pass
+        bool isBusy = false;
+        status = mtu_mixspi_nor_read_busy(&s_userConfig, kFlashInstMode_SPI, &isBusy);
+        if ((status == kStatus_Success) && (!isBusy))
+        {
+            finishedRounds++;
+            if ((mtu_mixspi_nor_wait_ready(&s_userConfig, kFlashInstMode_SPI, kNorOp_EraseSector, &polls) !=
+                 kStatus_Success) || (!mtu_nor_suspend_is_erased(ambaAddr)))
+            {
+                printf("FAILURE: round %d, sector 0x%x is not erased.\r\n", round, offsetAddr);
+                failedRounds++;
+            }
+            continue;
+        }
+
+        uint32_t stallCycles = mtu_cycle_timer_count();
+        status = mtu_mixspi_nor_suspend(&s_userConfig);
+        uint32_t suspendCycles = mtu_cycle_timer_count() - stallCycles;
+        if (status != kStatus_Success)
+        {
+            printf("Suspend failure in round %d!\r\n", round);
+        }
+        readCycles = mtu_cycle_timer_count();
+        uint32_t checksum = mtu_nor_suspend_read(readAddr, readSize, &firstReadCycles);
+        readCycles = mtu_cycle_timer_count() - readCycles;
+        uint32_t resumeCycles = mtu_cycle_timer_count();
+        if (mtu_mixspi_nor_resume(&s_userConfig) != kStatus_Success)
+        {
+            status = kStatus_Fail;
+            printf("Resume failure in round %d!\r\n", round);
+        }
+        resumeCycles = mtu_cycle_timer_count() - resumeCycles;
+        stallCycles = mtu_cycle_timer_count() - stallCycles;
+
+        if (mtu_mixspi_nor_wait_ready(&s_userConfig, kFlashInstMode_SPI, kNorOp_EraseSector, &polls) != kStatus_Success)
+        {
+            status = kStatus_Fail;
+        }
+        eraseTime = mtu_cycle_timer_clock() - eraseTime;
+
+        if (checksum != idleChecksum)
+        {
+            status = kStatus_Fail;
+            printf("FAILURE: round %d, data read while erase was suspended differs from idle read.\r\n", round);
+        }
+        if (!mtu_nor_suspend_is_erased(ambaAddr))
+        {
+            status = kStatus_Fail;
+            printf("FAILURE: round %d, sector 0x%x is not erased after resume.\r\n", round, offsetAddr);
+        }
+        if (status != kStatus_Success)
+        {
+            failedRounds++;
+            continue;
+        }
+        mtu_nor_suspend_stat_add(kNorSuspendMetric_Suspend, suspendCycles);
+        mtu_nor_suspend_stat_add(kNorSuspendMetric_FirstRead, firstReadCycles);
+        mtu_nor_suspend_stat_add(kNorSuspendMetric_Read, readCycles);
+        mtu_nor_suspend_stat_add(kNorSuspendMetric_Resume, resumeCycles);
+        mtu_nor_suspend_stat_add(kNorSuspendMetric_XipStall, stallCycles);
+        mtu_nor_suspend_stat_add(kNorSuspendMetric_Erase, (uint32_t)eraseTime);
+        passedRounds++;
+    }
+    mtu_perf_timebase_stop();
+
+    if (passedRounds)
+    {
+        printf("%-16s %12s %12s %12s\r\n", "Latency (us)", "min", "avg", "max");
+        for (uint32_t metric = 0; metric < kNorSuspendMetric_MaxIdx; metric++)
+        {
+            nor_suspend_stat_t *stat = &s_norSuspendStat[metric];
+            printf("%-16s %12.2f %12.2f %12.2f\r\n", s_norSuspendMetricName[metric], (float)stat->min / cyclesPerUs,
+                   (float)stat->sum / passedRounds / cyclesPerUs, (float)stat->max / cyclesPerUs);
+        }
+        printf("Suspended after %d us of erase, 0x%x bytes read per suspend.\r\n", suspendDelayUs, readSize);
+    }
+
+    if (finishedRounds)
+    {
+        printf("%d rounds skipped, erase finished within %d us before suspend.\r\n", finishedRounds, suspendDelayUs);
+    }
+    if (failedRounds || (!passedRounds))
+    {
+        printf("%d rounds failed, %d rounds suspended.\r\n", failedRounds, passedRounds);
+        printf("Done and Failed!\r\n");
+        return kStatus_Fail;
+    }
+
+    printf("Done and Passed!\r\n");
+    return kStatus_Success;
+}
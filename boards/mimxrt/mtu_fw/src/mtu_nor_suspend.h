@@ -0,0 +1,40 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _MTU_NOR_SUSPEND_H_
+#define _MTU_NOR_SUSPEND_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "fsl_common.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+//! @brief Bytes read over AHB while erase is suspended, taken from the region next to erased sector.
+#define MTU_NOR_SUSPEND_MAX_READ_SIZE  (0x1000)
+
+//! @brief Latencies measured in each round, reported as min/avg/max.
+enum _nor_suspend_metrics
+{
+    kNorSuspendMetric_Suspend   = 0x00,    // Suspend command until device is ready for reads
+    kNorSuspendMetric_FirstRead = 0x01,    // First AHB word read after suspend
+    kNorSuspendMetric_Read      = 0x02,    // All AHB reads of the read region
+    kNorSuspendMetric_Resume    = 0x03,    // Resume command
+    kNorSuspendMetric_XipStall  = 0x04,    // Suspend + reads + resume, as seen by XIP consumer
+    kNorSuspendMetric_Erase     = 0x05,    // Erase start until erase done, suspended time included
+    kNorSuspendMetric_MaxIdx,
+};
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+status_t mtu_nor_suspend_run(uint32_t rounds, uint32_t suspendDelayUs, uint32_t memStart, uint32_t memSize);
+
+#endif /* _MTU_NOR_SUSPEND_H_ */
@@ -0,0 +1,203 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "mtu.h"
+#include "fsl_cache.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+//! @brief Totals of one AHB sync policy, in CPU cycles.
+typedef struct _nor_xip_result
+{
+    uint64_t totalCycles;
+    uint64_t programCycles;
+    uint64_t readCycles;
+    uint64_t firstReadCycles;
+    uint32_t pages;
+    uint32_t failures;
+} nor_xip_result_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+static uint32_t mtu_nor_xip_read(uint32_t ambaAddr, uint32_t readSize, uint64_t *firstReadCycles);
+
+static void mtu_nor_xip_run_policy(nor_xip_result_t *result, uint32_t rounds, uint32_t offsetAddr, uint32_t ambaAddr,
+                                   uint32_t readSize);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static nor_xip_result_t s_norXipResult[kNorAhbSync_MaxIdx];
+
+//! @brief Source of page program, it must be in RAM while flash is busy.
+static uint32_t s_norXipPageBuffer[MTU_MEM_NOR_PAGE_SIZE / 4];
+
+static const char *const s_norXipPolicyName[kNorAhbSync_MaxIdx] = {"Software reset", "AHB buffer clear"};
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static uint32_t mtu_nor_xip_read(uint32_t ambaAddr, uint32_t readSize, uint64_t *firstReadCycles)
+{
+#if defined(MTU_CACHE_MAINTAIN) && MTU_CACHE_MAINTAIN
+    // Reads must reach FlexSPI, as a cache miss of XIP consumer does
+    DCACHE_InvalidateByRange(ambaAddr, readSize);
+#endif
+    uint32_t cycles = mtu_cycle_timer_count();
+    uint32_t checksum = *(volatile uint32_t *)ambaAddr;
+    *firstReadCycles += mtu_cycle_timer_count() - cycles;
+    for (uint32_t offset = 4; offset < readSize; offset += 4)
+    {
+        checksum ^= *(volatile uint32_t *)(ambaAddr + offset) + offset;
+    }
+
+    return checksum;
+}
+
+static void mtu_nor_xip_run_policy(nor_xip_result_t *result, uint32_t rounds, uint32_t offsetAddr, uint32_t ambaAddr,
+                                   uint32_t readSize)
+{
+    uint32_t readAddr = ambaAddr + MTU_MEM_NOR_SECTOR_SIZE;
+    uint64_t dummyCycles = 0;
+    uint32_t idleChecksum = mtu_nor_xip_read(readAddr, readSize, &dummyCycles);
+
+    uint64_t startTime = mtu_cycle_timer_clock();
+    for (uint32_t round = 1; round <= rounds; round++)
+    {
+        if (mtu_mixspi_nor_erase_sector(&s_userConfig, offsetAddr, kFlashInstMode_SPI) != kStatus_Success)
+        {
+            printf("Erase flash sector failure at address 0x%x!\r\n", offsetAddr);
+            result->failures++;
+            break;
+        }
+        // Program one page, then let XIP consumer read, as firmware update running next to XIP code does
+        for (uint32_t pageOffset = 0; pageOffset < MTU_MEM_NOR_SECTOR_SIZE; pageOffset += MTU_MEM_NOR_PAGE_SIZE)
+        {
+            for (uint32_t i = 0; i < ARRAY_SIZE(s_norXipPageBuffer); i++)
+            {
+                s_norXipPageBuffer[i] = ((pageOffset / 4) + i) ^ round;
+            }
+            uint64_t cycles = mtu_cycle_timer_clock();
+            status_t status = mtu_mixspi_nor_page_program(&s_userConfig, &s_nordeviceconfig, offsetAddr + pageOffset,
+                                                          (const uint32_t *)s_norXipPageBuffer, MTU_MEM_NOR_PAGE_SIZE,
+                                                          kFlashInstMode_SPI);
+            result->programCycles += mtu_cycle_timer_clock() - cycles;
+            if (status != kStatus_Success)
+            {
+                printf("Program flash page failure at address 0x%x!\r\n", offsetAddr + pageOffset);
+                result->failures++;
+                break;
+            }
+
+            cycles = mtu_cycle_timer_clock();
+            uint32_t checksum = mtu_nor_xip_read(readAddr, readSize, &result->firstReadCycles);
+            result->readCycles += mtu_cycle_timer_clock() - cycles;
+            result->pages++;
+            if (checksum != idleChecksum)
+            {
+                printf("FAILURE: XIP data changed after program at address 0x%x.\r\n", offsetAddr + pageOffset);
+                result->failures++;
+            }
+        }
+
+        // Programmed sector must read back over AHB, stale AHB buffer would show up here
+#if defined(MTU_CACHE_MAINTAIN) && MTU_CACHE_MAINTAIN
+        DCACHE_InvalidateByRange(ambaAddr, MTU_MEM_NOR_SECTOR_SIZE);
+#endif
+        for (uint32_t offset = 0; offset < MTU_MEM_NOR_SECTOR_SIZE; offset += 4)
+        {
+            if (*(volatile uint32_t *)(ambaAddr + offset) != ((offset / 4) ^ round))
+            {
+                printf("FAILURE: round %d, 0x%08x != 0x%08x at address 0x%08x.\r\n", round,
+                       *(volatile uint32_t *)(ambaAddr + offset), (offset / 4) ^ round, ambaAddr + offset);
+                result->failures++;
+                break;
+            }
+        }
+    }
+    result->totalCycles = mtu_cycle_timer_clock() - startTime;
+}
+
+status_t mtu_nor_xip_run(uint32_t rounds, uint32_t readSize, uint32_t memStart, uint32_t memSize)
+{
+    printf("Arg List: rounds=%d, readSize=0x%x, memStart=0x%x, memSize=0x%x.\n", rounds, readSize, memStart, memSize);
+
+    if (s_configSystemPacket.memProperty.type > kMemType_FlashMaxIdx)
+    {
+        printf("XIP/program test only runs on NOR Flash.\r\n");
+        return kStatus_InvalidArgument;
+    }
+    uint32_t offsetAddr = mtu_memory_convert_to_offset_addr(memStart);
+    if ((offsetAddr & (MTU_MEM_NOR_SECTOR_SIZE - 1)) || (memSize < 2 * MTU_MEM_NOR_SECTOR_SIZE))
+    {
+        printf("Test memory region must be aligned with flash sector and contain two sectors at least.\r\n");
+        return kStatus_InvalidArgument;
+    }
+    if (!rounds)
+    {
+        rounds = 1;
+    }
+    // First sector is programmed, the rest is read by XIP consumer
+    if (!readSize)
+    {
+        readSize = MTU_NOR_XIP_DEFAULT_READ_SIZE;
+    }
+    readSize &= ~0x3UL;
+    if (readSize > memSize - MTU_MEM_NOR_SECTOR_SIZE)
+    {
+        readSize = memSize - MTU_MEM_NOR_SECTOR_SIZE;
+    }
+    uint32_t ambaAddr = offsetAddr + bsp_mixspi_get_amba_base(&s_userConfig);
+
+    memset(s_norXipResult, 0, sizeof(s_norXipResult));
+    uint8_t lastPolicy = mtu_mixspi_nor_get_ahb_sync_policy();
+    mtu_perf_timebase_start();
+    for (uint8_t policy = 0; policy < kNorAhbSync_MaxIdx; policy++)
+    {
+        mtu_mixspi_nor_set_ahb_sync_policy(policy);
+        mtu_nor_xip_run_policy(&s_norXipResult[policy], rounds, offsetAddr, ambaAddr, readSize);
+    }
+    mtu_perf_timebase_stop();
+    mtu_mixspi_nor_set_ahb_sync_policy(lastPolicy);
+
+    float cyclesPerUs = (float)mtu_cycle_timer_clocks_per_sec() / 1000000;
+    uint32_t failures = 0;
+    printf("%-18s %10s %12s %12s %12s\r\n", "AHB sync policy", "Total ms", "Program us", "XIP read us",
+           "First rd us");
+    for (uint8_t policy = 0; policy < kNorAhbSync_MaxIdx; policy++)
+    {
+        nor_xip_result_t *result = &s_norXipResult[policy];
+        uint32_t pages = result->pages ? result->pages : 1;
+        printf("%-18s %10.1f %12.2f %12.2f %12.3f\r\n", s_norXipPolicyName[policy],
+               (float)result->totalCycles / cyclesPerUs / 1000, (float)result->programCycles / pages / cyclesPerUs,
+               (float)result->readCycles / pages / cyclesPerUs, (float)result->firstReadCycles / pages / cyclesPerUs);
+        failures += result->failures;
+    }
+    nor_xip_result_t *reset = &s_norXipResult[kNorAhbSync_Reset];
+    nor_xip_result_t *clear = &s_norXipResult[kNorAhbSync_ClearBuffer];
+    if (reset->totalCycles)
+    {
+        printf("Per page program + 0x%x bytes XIP read, buffer clear saves %.1f%% of total time.\r\n", readSize,
+               100.0f * ((float)reset->totalCycles - (float)clear->totalCycles) / (float)reset->totalCycles);
+    }
+
+    if (failures)
+    {
+        printf("%d failures.\r\n", failures);
+        printf("Done and Failed!\r\n");
+        return kStatus_Fail;
+    }
+
+    printf("Done and Passed!\r\n");
+    return kStatus_Success;
+}
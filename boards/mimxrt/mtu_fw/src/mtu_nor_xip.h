@@ -0,0 +1,28 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _MTU_NOR_XIP_H_
+#define _MTU_NOR_XIP_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "fsl_common.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+//! @brief Bytes read over AHB after every page program, when block size is not given.
+#define MTU_NOR_XIP_DEFAULT_READ_SIZE  (0x400)
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+status_t mtu_nor_xip_run(uint32_t rounds, uint32_t readSize, uint32_t memStart, uint32_t memSize);
+
+#endif /* _MTU_NOR_XIP_H_ */
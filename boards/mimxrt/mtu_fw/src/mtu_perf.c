@@ -0,0 +1,274 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "mtu.h"
+#include "fsl_cache.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+static status_t mtu_perf_code_load(uint8_t codePlacement, uint32_t codeDst, uint32_t codeSrc, uint32_t codeSize, uint32_t *codeStart);
+
+static void mtu_perf_ext_mem_cache(uint32_t memStart, uint32_t size);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+//! @brief Link-time range of the code block that is currently relocated.
+static uint32_t s_perfCodeLinkStart;
+static uint32_t s_perfCodeLinkSize;
+//! @brief Execution address minus link address of relocated code block.
+static uint32_t s_perfCodeOffset;
+
+static const char *const s_perfPlacementName[kPerfMemPlacement_MaxIdx] = {"TCM", "OCRAM", "ExtMem"};
+
+//! @brief ExtMem part of the run is mapped write-back, instead of board default MPU attribute.
+static bool s_isPerfExtMemCached;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static status_t mtu_perf_code_load(uint8_t codePlacement, uint32_t codeDst, uint32_t codeSrc, uint32_t codeSize, uint32_t *codeStart)
+{
+    if (codePlacement == kPerfMemPlacement_ExtMem)
+    {
+#if MTU_FEATURE_EXT_MEMORY
+        status_t status = mtu_memory_load(s_configSystemPacket.memProperty.type, codeDst, (const uint8_t *)codeSrc, codeSize, codeStart);
+        if (status != kStatus_Success)
+        {
+            return status;
+        }
+#else
+        return kStatus_Fail;
+#endif
+    }
+    else
+    {
+        memcpy((void *)codeDst, (const void *)codeSrc, codeSize);
+        *codeStart = codeDst;
+    }
+
+    // New code must be visible to instruction fetch, not only sit in D-Cache
+    DCACHE_CleanInvalidateByRange(*codeStart, codeSize);
+    ICACHE_InvalidateByRange(*codeStart, codeSize);
+    __DSB();
+    __ISB();
+
+    return kStatus_Success;
+}
+
+static void mtu_perf_ext_mem_cache(uint32_t memStart, uint32_t size)
+{
+#if MTU_FEATURE_EXT_MEMORY
+    // Board maps FlexSPI window as device unless FW is XIP, code/data there would run uncached
+    uint32_t ambaAddr = mtu_memory_convert_to_offset_addr(memStart) + bsp_mixspi_get_amba_base(&s_userConfig);
+    s_isPerfExtMemCached = (bsp_rt_system_set_mem_attr(ambaAddr, size, kBspMemAttr_WriteBack) == kStatus_Success);
+#endif
+}
+
+status_t mtu_perf_mem_setup(uint8_t memPlacement, uint32_t memStart, uint32_t memSize, perf_mem_layout_t *layout)
+{
+    uint8_t codePlacement = MTU_PERF_CODE_PLACEMENT(memPlacement);
+    uint8_t dataPlacement = MTU_PERF_DATA_PLACEMENT(memPlacement);
+    uint32_t memEnd = memStart + memSize;
+    uint32_t extMemStart = memStart;
+    uint32_t ocramStart;
+    uint32_t ocramSize;
+    bsp_rt_system_scratch_sram(&ocramStart, &ocramSize);
+    uint32_t ocramEnd = ocramStart + ocramSize;
+
+    if ((codePlacement >= kPerfMemPlacement_MaxIdx) || (dataPlacement >= kPerfMemPlacement_MaxIdx))
+    {
+        printf("Invalid code/data placement 0x%x.\r\n", memPlacement);
+        return kStatus_InvalidArgument;
+    }
+#if MTU_FEATURE_EXT_MEMORY
+    if ((dataPlacement == kPerfMemPlacement_ExtMem) &&
+        (s_configSystemPacket.memProperty.type <= kMemType_FlashMaxIdx))
+    {
+        printf("Data can not be placed in NOR Flash, it is not writable by CPU.\r\n");
+        return kStatus_InvalidArgument;
+    }
+#else
+    if ((codePlacement == kPerfMemPlacement_ExtMem) || (dataPlacement == kPerfMemPlacement_ExtMem))
+    {
+        printf("External memory is not supported.\r\n");
+        return kStatus_InvalidArgument;
+    }
+#endif
+
+    layout->codePlacement = codePlacement;
+    layout->dataPlacement = dataPlacement;
+    s_perfCodeLinkStart = layout->codeStart;
+    s_perfCodeLinkSize = 0;
+    s_perfCodeOffset = 0;
+
+    if (codePlacement != kPerfMemPlacement_Tcm)
+    {
+        uint32_t codeDst;
+        if (!layout->codeSize)
+        {
+            printf("Code block is not defined by linker, code will be executed from TCM.\r\n");
+            layout->codePlacement = kPerfMemPlacement_Tcm;
+        }
+        else
+        {
+            if (codePlacement == kPerfMemPlacement_Ocram)
+            {
+                codeDst = ocramStart;
+                ocramStart += MTU_PERF_ALIGN_UP(layout->codeSize, 32);
+            }
+            else
+            {
+                codeDst = memStart;
+                memStart += MTU_PERF_ALIGN_UP(layout->codeSize, MTU_PERF_EXT_MEM_ALIGNMENT);
+            }
+            if ((ocramStart > ocramEnd) || (memStart > memEnd))
+            {
+                printf("No enough memory to hold code block (%d bytes).\r\n", layout->codeSize);
+                return kStatus_OutOfRange;
+            }
+            status_t status = mtu_perf_code_load(codePlacement, codeDst, layout->codeStart, layout->codeSize, &codeDst);
+            if (status != kStatus_Success)
+            {
+                printf("Failed to load code block to 0x%x.\r\n", codeDst);
+                return status;
+            }
+            s_perfCodeLinkSize = layout->codeSize;
+            s_perfCodeOffset = codeDst - layout->codeStart;
+            layout->codeStart = codeDst;
+        }
+    }
+
+    layout->dataStart = 0;
+    if (dataPlacement == kPerfMemPlacement_Ocram)
+    {
+        layout->dataStart = ocramStart;
+        ocramStart += layout->dataSize;
+    }
+    else if (dataPlacement == kPerfMemPlacement_ExtMem)
+    {
+        layout->dataStart = memStart;
+        memStart += layout->dataSize;
+    }
+    if ((ocramStart > ocramEnd) || (memStart > memEnd))
+    {
+        mtu_perf_mem_restore();
+        printf("No enough memory to hold data block (%d bytes).\r\n", layout->dataSize);
+        return kStatus_OutOfRange;
+    }
+    if (memStart != extMemStart)
+    {
+        mtu_perf_ext_mem_cache(extMemStart, memStart - extMemStart);
+    }
+
+    return kStatus_Success;
+}
+
+void mtu_perf_mem_restore(void)
+{
+    s_perfCodeLinkSize = 0;
+    s_perfCodeOffset = 0;
+    if (s_isPerfExtMemCached)
+    {
+        bsp_rt_system_restore_mem_attr();
+        s_isPerfExtMemCached = false;
+    }
+}
+
+uint32_t mtu_perf_code_addr(uint32_t linkAddr)
+{
+    if ((linkAddr >= s_perfCodeLinkStart) && (linkAddr < s_perfCodeLinkStart + s_perfCodeLinkSize))
+    {
+        return linkAddr + s_perfCodeOffset;
+    }
+
+    return linkAddr;
+}
+
+const char *mtu_perf_placement_name(uint8_t placement)
+{
+    if (placement < kPerfMemPlacement_MaxIdx)
+    {
+        return s_perfPlacementName[placement];
+    }
+
+    return "Unknown";
+}
+
+void mtu_perf_mem_print(const perf_mem_layout_t *layout)
+{
+    printf("Code in %s [0x%08X - 0x%08X)\r\n", mtu_perf_placement_name(layout->codePlacement),
+           layout->codeStart, layout->codeStart + layout->codeSize);
+    if (layout->dataStart)
+    {
+        printf("Data in %s [0x%08X - 0x%08X)\r\n", mtu_perf_placement_name(layout->dataPlacement),
+               layout->dataStart, layout->dataStart + layout->dataSize);
+    }
+    else
+    {
+        printf("Data in %s\r\n", mtu_perf_placement_name(layout->dataPlacement));
+    }
+    if ((layout->codePlacement == kPerfMemPlacement_ExtMem) || (layout->dataPlacement == kPerfMemPlacement_ExtMem))
+    {
+        printf("ExtMem is %s\r\n", s_isPerfExtMemCached ? "mapped write-back cacheable" :
+                                                           "left with board MPU attribute, results may be uncached");
+    }
+}
+
+void mtu_perf_timebase_start(void)
+{
+    mtu_cycle_timer_init();
+    // Keep sampling CYCCNT, so its wraps are not lost during a long run
+    mtu_task_timer_init(MTU_PERF_TIMEBASE_UPDATE_MS, (void *)mtu_cycle_timer_update);
+}
+
+uint64_t mtu_perf_timebase_clock(void)
+{
+    return mtu_cycle_timer_clock();
+}
+
+void mtu_perf_timebase_stop(void)
+{
+    mtu_task_timer_deinit();
+    mtu_cycle_timer_deinit();
+}
+
+//! @brief Read whole range by word, returns checksum so reads are not optimized out.
+uint32_t mtu_perf_read_seq(uint32_t ambaAddr, uint32_t size)
+{
+    uint32_t checksum = 0;
+    for (uint32_t offset = 0; offset < size; offset += 4)
+    {
+        checksum ^= *(volatile uint32_t *)(ambaAddr + offset);
+    }
+
+    return checksum;
+}
+
+//! @brief Read words at pseudo-random addresses of range, returns checksum.
+uint32_t mtu_perf_read_random(uint32_t ambaAddr, uint32_t size, uint32_t reads)
+{
+    // Fixed seed, so every measured config sees the same address sequence
+    uint32_t state = 0x12345678UL;
+    uint32_t checksum = 0;
+    for (uint32_t read = 0; read < reads; read++)
+    {
+        state = state * 1664525UL + 1013904223UL;
+        checksum ^= *(volatile uint32_t *)(ambaAddr + (((state >> 8) % size) & ~3UL));
+    }
+
+    return checksum;
+}
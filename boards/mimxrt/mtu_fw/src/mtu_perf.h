@@ -0,0 +1,67 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _MTU_PERF_H_
+#define _MTU_PERF_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "fsl_common.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+//! @brief Cycle timer is sampled by this period to extend 32bit DWT CYCCNT to 64bit.
+#define MTU_PERF_TIMEBASE_UPDATE_MS (1000)
+
+//! @brief External memory is loaded/erased by sector, so relocated code/data are aligned to it.
+#define MTU_PERF_EXT_MEM_ALIGNMENT  (0x1000)
+
+#define MTU_PERF_ALIGN_UP(x, align) (((x) + (align) - 1) & ~((align) - 1))
+
+//! @brief Get code/data placement from perf test packet memPlacement field.
+#define MTU_PERF_CODE_PLACEMENT(x)  ((x) & 0x0F)
+#define MTU_PERF_DATA_PLACEMENT(x)  (((x) >> 4) & 0x0F)
+
+//! @brief Code/data placement info of one perf run.
+typedef struct _perf_mem_layout
+{
+    uint8_t codePlacement;
+    uint8_t dataPlacement;
+    uint8_t reserved0[2];
+    uint32_t codeStart;       // In: link address of code block, Out: address it is executed from
+    uint32_t codeSize;        // In: 0 if code block is not defined by linker
+    uint32_t dataStart;       // Out: 0 means benchmark uses its own static (DTCM) buffer
+    uint32_t dataSize;        // In
+} perf_mem_layout_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+status_t mtu_perf_mem_setup(uint8_t memPlacement, uint32_t memStart, uint32_t memSize, perf_mem_layout_t *layout);
+
+void     mtu_perf_mem_restore(void);
+
+uint32_t mtu_perf_code_addr(uint32_t linkAddr);
+
+const char *mtu_perf_placement_name(uint8_t placement);
+
+void     mtu_perf_mem_print(const perf_mem_layout_t *layout);
+
+void     mtu_perf_timebase_start(void);
+
+uint64_t mtu_perf_timebase_clock(void);
+
+void     mtu_perf_timebase_stop(void);
+
+uint32_t mtu_perf_read_seq(uint32_t ambaAddr, uint32_t size);
+
+uint32_t mtu_perf_read_random(uint32_t ambaAddr, uint32_t size, uint32_t reads);
+
+#endif /* _MTU_PERF_H_ */
@@ -0,0 +1,304 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "mtu.h"
+#include "fsl_cache.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+//! @brief Only first mismatches of each step are printed, the rest are just counted.
+#define MTU_PROBE_MAX_REPORTED_FAILURES (8)
+
+//! @brief FlexSPI DATA lines, a byte is shifted out on DATA[7:0] (octal/HyperBus) or DATA[3:0] twice (quad).
+#define MTU_PROBE_DATA_LINES            (8)
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+static inline void mtu_probe_write(uint32_t addr, uint32_t value);
+
+static inline uint32_t mtu_probe_read(uint32_t addr);
+
+static void mtu_probe_report(const char *step, uint32_t addr, uint32_t actual, uint32_t expected);
+
+static uint32_t mtu_probe_data_lines(uint32_t bitMask);
+
+static uint32_t mtu_probe_data_bus(uint32_t memStart);
+
+static uint32_t mtu_probe_device_size(uint32_t memStart, uint32_t memSize);
+
+static uint32_t mtu_probe_addr_bus(uint32_t memStart, uint32_t memSize);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+//! @brief Data bits read as 1 when 0 was written, and read as 0 when 1 was written.
+static uint32_t s_probeDataStuckHigh;
+static uint32_t s_probeDataStuckLow;
+
+//! @brief Offsets (power of 2) aliasing to test start, and faulty address bits.
+static uint32_t s_probeAliasMap;
+static uint32_t s_probeAddrStuckHigh;
+static uint32_t s_probeAddrStuckLow;
+
+static uint32_t s_probeStepFailures;
+
+static const char *const s_probeStepName[kProbeStep_MaxIdx] = {"Data bus", "Device size", "Address bus"};
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static inline void mtu_probe_write(uint32_t addr, uint32_t value)
+{
+    *(volatile uint32_t *)addr = value;
+#if defined(MTU_CACHE_MAINTAIN) && MTU_CACHE_MAINTAIN
+    // Every access must go to the device, or wiring faults are hidden by cache
+    DCACHE_CleanInvalidateByRange(addr, 4);
+#endif
+}
+
+static inline uint32_t mtu_probe_read(uint32_t addr)
+{
+#if defined(MTU_CACHE_MAINTAIN) && MTU_CACHE_MAINTAIN
+    DCACHE_InvalidateByRange(addr, 4);
+#endif
+    return *(volatile uint32_t *)addr;
+}
+
+static void mtu_probe_report(const char *step, uint32_t addr, uint32_t actual, uint32_t expected)
+{
+    s_probeStepFailures++;
+    if (s_probeStepFailures <= MTU_PROBE_MAX_REPORTED_FAILURES)
+    {
+        printf("FAILURE: %s 0x%08x != 0x%08x at address 0x%08x.\r\n", step, actual, expected, addr);
+    }
+}
+
+static uint32_t mtu_probe_data_lines(uint32_t bitMask)
+{
+    // Bit k of every byte goes through DATA[k], so a bad line shows up in all bytes of the word
+    uint32_t lineMask = 0;
+    for (uint32_t byteIdx = 0; byteIdx < 4; byteIdx++)
+    {
+        lineMask |= (bitMask >> (byteIdx * MTU_PROBE_DATA_LINES)) & ((1UL << MTU_PROBE_DATA_LINES) - 1);
+    }
+
+    return lineMask;
+}
+
+static uint32_t mtu_probe_data_bus(uint32_t memStart)
+{
+    s_probeStepFailures = 0;
+    for (uint32_t bit = 0; bit < 32; bit++)
+    {
+        // Walking 1s, then walking 0s, at the same address
+        uint32_t patterns[2] = {1UL << bit, ~(1UL << bit)};
+        for (uint32_t i = 0; i < ARRAY_SIZE(patterns); i++)
+        {
+            mtu_probe_write(memStart, patterns[i]);
+            uint32_t actual = mtu_probe_read(memStart);
+            if (actual != patterns[i])
+            {
+                s_probeDataStuckHigh |= actual & ~patterns[i];
+                s_probeDataStuckLow |= ~actual & patterns[i];
+                mtu_probe_report(i ? "walking 0" : "walking 1", memStart, actual, patterns[i]);
+            }
+        }
+    }
+
+    return s_probeStepFailures;
+}
+
+static uint32_t mtu_probe_device_size(uint32_t memStart, uint32_t memSize)
+{
+    s_probeStepFailures = 0;
+    mtu_probe_write(memStart, MTU_PROBE_PATTERN);
+    for (uint32_t offset = 4; offset < memSize; offset <<= 1)
+    {
+        mtu_probe_write(memStart + offset, MTU_PROBE_ANTIPATTERN);
+        if (mtu_probe_read(memStart) != MTU_PROBE_PATTERN)
+        {
+            s_probeAliasMap |= offset;
+            mtu_probe_write(memStart, MTU_PROBE_PATTERN);
+        }
+    }
+
+    // Device wraps at the lowest offset all above ones alias too, isolated aliases are address faults
+    uint32_t deviceSize = 0;
+    for (uint32_t offset = 0x80000000UL; offset >= 4; offset >>= 1)
+    {
+        if (offset >= memSize)
+        {
+            continue;
+        }
+        if (!(s_probeAliasMap & offset))
+        {
+            break;
+        }
+        deviceSize = offset;
+    }
+    if (s_probeAliasMap & ~(deviceSize ? (0UL - deviceSize) : 0))
+    {
+        printf("FAILURE: Device size offsets 0x%08x alias to address 0x%08x.\r\n",
+               s_probeAliasMap & ~(deviceSize ? (0UL - deviceSize) : 0), memStart);
+        s_probeStepFailures++;
+    }
+
+    return deviceSize;
+}
+
+static uint32_t mtu_probe_addr_bus(uint32_t memStart, uint32_t memSize)
+{
+    s_probeStepFailures = 0;
+    for (uint32_t offset = 4; offset < memSize; offset <<= 1)
+    {
+        mtu_probe_write(memStart + offset, MTU_PROBE_PATTERN);
+    }
+
+    // Address bits stuck high: writing test start also overwrites a power of 2 offset
+    mtu_probe_write(memStart, MTU_PROBE_ANTIPATTERN);
+    for (uint32_t offset = 4; offset < memSize; offset <<= 1)
+    {
+        uint32_t actual = mtu_probe_read(memStart + offset);
+        if (actual != MTU_PROBE_PATTERN)
+        {
+            s_probeAddrStuckHigh |= offset;
+            mtu_probe_report("address stuck high", memStart + offset, actual, MTU_PROBE_PATTERN);
+        }
+    }
+    mtu_probe_write(memStart, MTU_PROBE_PATTERN);
+
+    // Address bits stuck low or shorted: writing one offset overwrites test start or another offset
+    for (uint32_t testOffset = 4; testOffset < memSize; testOffset <<= 1)
+    {
+        mtu_probe_write(memStart + testOffset, MTU_PROBE_ANTIPATTERN);
+        for (uint32_t offset = 0; offset < memSize; offset = offset ? (offset << 1) : 4)
+        {
+            if (offset == testOffset)
+            {
+                continue;
+            }
+            uint32_t actual = mtu_probe_read(memStart + offset);
+            if (actual != MTU_PROBE_PATTERN)
+            {
+                s_probeAddrStuckLow |= testOffset;
+                mtu_probe_report("address stuck low/shorted", memStart + offset, actual, MTU_PROBE_PATTERN);
+                mtu_probe_write(memStart + offset, MTU_PROBE_PATTERN);
+            }
+        }
+        mtu_probe_write(memStart + testOffset, MTU_PROBE_PATTERN);
+    }
+
+    return s_probeStepFailures;
+}
+
+status_t mtu_probe_run(uint32_t loops, bool stopWhenFail, uint32_t memStart, uint32_t memSize)
+{
+    printf("Arg List: loops=%d, fail_stop=%d, memStart=0x%x, memSize=0x%x.\n", loops, stopWhenFail, memStart, memSize);
+
+    if ((memStart & 0x3) || (memSize < 8))
+    {
+        printf("Test memory region must be word aligned and at least 2 words.\r\n");
+        return kStatus_InvalidArgument;
+    }
+#if MTU_FEATURE_EXT_MEMORY
+    if (s_configSystemPacket.memProperty.type <= kMemType_FlashMaxIdx)
+    {
+        printf("NOR Flash is not writable by CPU, bus probe is not supported.\r\n");
+        return kStatus_InvalidArgument;
+    }
+#endif
+    if (!loops)
+    {
+        loops = 1;
+    }
+
+    s_probeDataStuckHigh = 0;
+    s_probeDataStuckLow = 0;
+    s_probeAliasMap = 0;
+    s_probeAddrStuckHigh = 0;
+    s_probeAddrStuckLow = 0;
+    uint32_t failureMap = 0;
+    uint32_t deviceSize = 0;
+    uint32_t stepCycles[kProbeStep_MaxIdx] = {0};
+    mtu_perf_timebase_start();
+    for (uint32_t loop = 1; (loop <= loops) && !(stopWhenFail && failureMap); loop++)
+    {
+        uint32_t cycles = mtu_cycle_timer_count();
+        if (mtu_probe_data_bus(memStart))
+        {
+            failureMap |= 1UL << kProbeStep_DataBus;
+        }
+        stepCycles[kProbeStep_DataBus] += mtu_cycle_timer_count() - cycles;
+        // Address steps are meaningless if data word cannot be stored
+        if (stopWhenFail && failureMap)
+        {
+            break;
+        }
+
+        cycles = mtu_cycle_timer_count();
+        deviceSize = mtu_probe_device_size(memStart, memSize);
+        if (s_probeStepFailures)
+        {
+            failureMap |= 1UL << kProbeStep_DeviceSize;
+        }
+        stepCycles[kProbeStep_DeviceSize] += mtu_cycle_timer_count() - cycles;
+
+        // Offsets beyond device size alias by design, only address lines inside device are checked
+        cycles = mtu_cycle_timer_count();
+        if (mtu_probe_addr_bus(memStart, deviceSize ? deviceSize : memSize))
+        {
+            failureMap |= 1UL << kProbeStep_AddrBus;
+        }
+        stepCycles[kProbeStep_AddrBus] += mtu_cycle_timer_count() - cycles;
+    }
+    float cyclesPerUs = (float)mtu_cycle_timer_clocks_per_sec() / 1000000;
+    mtu_perf_timebase_stop();
+
+    for (uint32_t step = 0; step < kProbeStep_MaxIdx; step++)
+    {
+        printf("%s: %s (%.1f us)\r\n", s_probeStepName[step], (failureMap & (1UL << step)) ? "failed" : "ok",
+               (float)stepCycles[step] / cyclesPerUs);
+    }
+    if (s_probeDataStuckHigh | s_probeDataStuckLow)
+    {
+        printf("Data bits read as 1: 0x%08x, read as 0: 0x%08x, suspect DATA lines mask: 0x%02x\r\n",
+               s_probeDataStuckHigh, s_probeDataStuckLow,
+               mtu_probe_data_lines(s_probeDataStuckHigh | s_probeDataStuckLow));
+        if ((s_probeDataStuckHigh | s_probeDataStuckLow) == 0xFFFFFFFFUL)
+        {
+            printf("All data bits failed, check SS_B/SCLK/DQS connection first.\r\n");
+        }
+    }
+    if (deviceSize)
+    {
+        printf("Device size: address wraps at offset 0x%x\r\n", deviceSize);
+    }
+    else
+    {
+        printf("Device size: no wrap within 0x%x bytes\r\n", memSize);
+    }
+    if (s_probeAddrStuckHigh | s_probeAddrStuckLow)
+    {
+        printf("Address bits (byte offset) stuck high: 0x%08x, stuck low/shorted: 0x%08x\r\n",
+               s_probeAddrStuckHigh, s_probeAddrStuckLow);
+    }
+
+    if (failureMap)
+    {
+        printf("Done and Failed!\r\n");
+        return kStatus_Fail;
+    }
+
+    printf("Done and Passed!\r\n");
+    return kStatus_Success;
+}
@@ -0,0 +1,38 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _MTU_PROBE_H_
+#define _MTU_PROBE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "fsl_common.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+//! @brief Probe steps, the result of each step is reported as a bit in failure map.
+enum _probe_steps
+{
+    kProbeStep_DataBus    = 0x00,    // Walking 1s/0s at one address
+    kProbeStep_DeviceSize = 0x01,    // Power of 2 offsets aliasing to the first word
+    kProbeStep_AddrBus    = 0x02,    // Power of 2 offsets stuck-high/stuck-low/shorted
+    kProbeStep_MaxIdx,
+};
+
+//! @brief Words written to power of 2 offsets by device size/address bus steps.
+#define MTU_PROBE_PATTERN      (0xAAAAAAAAUL)
+#define MTU_PROBE_ANTIPATTERN  (0x55555555UL)
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+status_t mtu_probe_run(uint32_t loops, bool stopWhenFail, uint32_t memStart, uint32_t memSize);
+
+#endif /* _MTU_PROBE_H_ */
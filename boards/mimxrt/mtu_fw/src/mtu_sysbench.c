@@ -0,0 +1,249 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "mtu.h"
+#include "memtester.h"
+#include "tests.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+//! @brief Statistics of one operation type.
+typedef struct _sysbench_op_stat
+{
+    uint32_t count;
+    uint32_t minCycles;
+    uint32_t maxCycles;
+    uint32_t reserved0;
+    uint64_t bytes;
+    uint64_t cycles;
+    uint32_t hist[MTU_SYSBENCH_HIST_BUCKETS];
+} sysbench_op_stat_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+static uint32_t mtu_sysbench_compute(const uint32_t *buf, uint32_t words, uint32_t rounds);
+
+static void mtu_sysbench_stat_add(sysbench_op_stat_t *stat, uint32_t cycles, uint32_t bytes);
+
+static void mtu_sysbench_stat_print(uint8_t op, const sysbench_op_stat_t *stat);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+//! @brief Local (DTCM) side of every transfer, also the input of compute phase.
+static uint32_t s_sysbenchBuffer[MTU_SYSBENCH_MAX_BLOCK_SIZE / 4];
+
+static sysbench_op_stat_t s_sysbenchStat[kSysbenchOp_MaxIdx];
+
+static const char *const s_sysbenchOpName[kSysbenchOp_MaxIdx] = {"Read", "Write", "Compute"};
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static uint32_t mtu_sysbench_compute(const uint32_t *buf, uint32_t words, uint32_t rounds)
+{
+    // Fletcher-like checksum, it stands for parsing/decoding of the transferred block
+    uint32_t sum1 = 0xFFFF;
+    uint32_t sum2 = 0xFFFF;
+    while (rounds--)
+    {
+        for (uint32_t i = 0; i < words; i++)
+        {
+            sum1 += buf[i] & 0xFFFF;
+            sum2 += sum1;
+            sum1 += buf[i] >> 16;
+            sum2 += sum1;
+        }
+        sum1 = (sum1 & 0xFFFF) + (sum1 >> 16);
+        sum2 = (sum2 & 0xFFFF) + (sum2 >> 16);
+    }
+
+    return (sum2 << 16) | (sum1 & 0xFFFF);
+}
+
+static void mtu_sysbench_stat_add(sysbench_op_stat_t *stat, uint32_t cycles, uint32_t bytes)
+{
+    uint32_t bucket = cycles ? (31 - __CLZ(cycles)) : 0;
+    if (bucket >= MTU_SYSBENCH_HIST_BUCKETS)
+    {
+        bucket = MTU_SYSBENCH_HIST_BUCKETS - 1;
+    }
+    stat->hist[bucket]++;
+    stat->count++;
+    stat->bytes += bytes;
+    stat->cycles += cycles;
+    if (cycles < stat->minCycles)
+    {
+        stat->minCycles = cycles;
+    }
+    if (cycles > stat->maxCycles)
+    {
+        stat->maxCycles = cycles;
+    }
+}
+
+static void mtu_sysbench_stat_print(uint8_t op, const sysbench_op_stat_t *stat)
+{
+    if (!stat->count)
+    {
+        return;
+    }
+
+    float cyclesPerUs = (float)mtu_cycle_timer_clocks_per_sec() / 1000000;
+    uint32_t avgCycles = (uint32_t)(stat->cycles / stat->count);
+    printf("%s: %d ops, %d KB, latency min/avg/max %d/%d/%d cycles (avg %.3f us)\r\n", s_sysbenchOpName[op],
+           stat->count, (uint32_t)(stat->bytes / 1024), stat->minCycles, avgCycles, stat->maxCycles,
+           (float)avgCycles / cyclesPerUs);
+
+    // Percentiles are resolved to the upper bound of log2 bucket
+    const uint32_t percentiles[] = {50, 95, 99};
+    uint32_t pctIdx = 0;
+    uint32_t accumulated = 0;
+    printf("  percentile upper bound:");
+    for (uint32_t bucket = 0; (bucket < MTU_SYSBENCH_HIST_BUCKETS) && (pctIdx < ARRAY_SIZE(percentiles)); bucket++)
+    {
+        accumulated += stat->hist[bucket];
+        while ((pctIdx < ARRAY_SIZE(percentiles)) && ((uint64_t)accumulated * 100 >= (uint64_t)stat->count * percentiles[pctIdx]))
+        {
+            printf(" p%d < %d cycles", percentiles[pctIdx], 2UL << bucket);
+            pctIdx++;
+        }
+    }
+    printf("\r\n");
+
+    for (uint32_t bucket = 0; bucket < MTU_SYSBENCH_HIST_BUCKETS; bucket++)
+    {
+        if (!stat->hist[bucket])
+        {
+            continue;
+        }
+        if (bucket == MTU_SYSBENCH_HIST_BUCKETS - 1)
+        {
+            printf("  [%8d,      inf) cycles: %8d (%5.1f%%)\r\n", 1UL << bucket, stat->hist[bucket],
+                   (float)stat->hist[bucket] * 100 / stat->count);
+        }
+        else
+        {
+            printf("  [%8d, %8d) cycles: %8d (%5.1f%%)\r\n", 1UL << bucket, 2UL << bucket, stat->hist[bucket],
+                   (float)stat->hist[bucket] * 100 / stat->count);
+        }
+    }
+}
+
+status_t mtu_sysbench_run(uint32_t operations, uint8_t readPercent, uint8_t computeRounds,
+                          uint32_t maxBlockSize, uint32_t memStart, uint32_t memSize)
+{
+    printf("Arg List: operations=%d, readPercent=%d, computeRounds=%d, maxBlockSize=0x%x, memStart=0x%x, memSize=0x%x.\n",
+           operations, readPercent, computeRounds, maxBlockSize, memStart, memSize);
+
+    if (!operations)
+    {
+        operations = MTU_SYSBENCH_DEFAULT_OPERATIONS;
+    }
+    if (readPercent == MTU_SYSBENCH_READ_PERCENT_NONE)
+    {
+        readPercent = 0;
+    }
+    else if ((!readPercent) || (readPercent > 100))
+    {
+        readPercent = MTU_SYSBENCH_DEFAULT_READ_PERCENT;
+    }
+    if ((!maxBlockSize) || (maxBlockSize > MTU_SYSBENCH_MAX_BLOCK_SIZE))
+    {
+        maxBlockSize = MTU_SYSBENCH_MAX_BLOCK_SIZE;
+    }
+    else if (maxBlockSize < MTU_SYSBENCH_MIN_BLOCK_SIZE)
+    {
+        maxBlockSize = MTU_SYSBENCH_MIN_BLOCK_SIZE;
+    }
+    if ((memStart & 0x3) || (memSize < maxBlockSize))
+    {
+        printf("Test memory region must be word aligned and not smaller than max block size.\r\n");
+        return kStatus_InvalidArgument;
+    }
+#if MTU_FEATURE_EXT_MEMORY
+    if ((s_configSystemPacket.memProperty.type <= kMemType_FlashMaxIdx) && (readPercent != 100))
+    {
+        printf("NOR Flash is not writable by CPU, only reads will be issued.\r\n");
+        readPercent = 100;
+    }
+#endif
+
+    // Transfer sizes are MIN_BLOCK_SIZE << [0, sizeSteps)
+    uint32_t sizeSteps = 0;
+    while ((MTU_SYSBENCH_MIN_BLOCK_SIZE << sizeSteps) <= maxBlockSize)
+    {
+        sizeSteps++;
+    }
+
+    // Fixed seed, so the same packet always replays the same operation sequence
+    rand_seed(MEMTESTER_DEFAULT_SEED);
+    for (uint32_t i = 0; i < ARRAY_SIZE(s_sysbenchBuffer); i++)
+    {
+        s_sysbenchBuffer[i] = rand_xorshift32();
+    }
+    memset(s_sysbenchStat, 0, sizeof(s_sysbenchStat));
+    for (uint32_t op = 0; op < kSysbenchOp_MaxIdx; op++)
+    {
+        s_sysbenchStat[op].minCycles = UINT32_MAX;
+    }
+
+    uint32_t checksum = 0;
+    mtu_perf_timebase_start();
+    uint64_t startTime = mtu_perf_timebase_clock();
+    for (uint32_t i = 0; i < operations; i++)
+    {
+        uint32_t size = MTU_SYSBENCH_MIN_BLOCK_SIZE << (rand_xorshift32() % sizeSteps);
+        uint32_t offset = (rand_xorshift32() % ((memSize - size) / 4 + 1)) * 4;
+        uint8_t op = ((rand_xorshift32() % 100) < readPercent) ? kSysbenchOp_Read : kSysbenchOp_Write;
+
+        uint32_t cycles = mtu_cycle_timer_count();
+        if (op == kSysbenchOp_Read)
+        {
+            memcpy(s_sysbenchBuffer, (const void *)(memStart + offset), size);
+        }
+        else
+        {
+            memcpy((void *)(memStart + offset), s_sysbenchBuffer, size);
+        }
+        cycles = mtu_cycle_timer_count() - cycles;
+        mtu_sysbench_stat_add(&s_sysbenchStat[op], cycles, size);
+
+        if (computeRounds)
+        {
+            cycles = mtu_cycle_timer_count();
+            checksum ^= mtu_sysbench_compute(s_sysbenchBuffer, size / 4, computeRounds);
+            cycles = mtu_cycle_timer_count() - cycles;
+            mtu_sysbench_stat_add(&s_sysbenchStat[kSysbenchOp_Compute], cycles, size);
+        }
+    }
+    uint64_t totalCycles = mtu_perf_timebase_clock() - startTime;
+    mtu_perf_timebase_stop();
+
+    float totalSecs = (float)totalCycles / (float)mtu_cycle_timer_clocks_per_sec();
+    uint64_t totalBytes = s_sysbenchStat[kSysbenchOp_Read].bytes + s_sysbenchStat[kSysbenchOp_Write].bytes;
+    printf("Mixed workload: %d ops (%d%% read) in %.3f s, block size 0x%x - 0x%x, compute rounds %d\r\n",
+           operations, readPercent, totalSecs, MTU_SYSBENCH_MIN_BLOCK_SIZE, maxBlockSize, computeRounds);
+    printf("Operations/sec: %.1f\r\n", (float)operations / totalSecs);
+    printf("Throughput: %.3f MiB/s\r\n", (float)totalBytes / 1024 / 1024 / totalSecs);
+    for (uint8_t op = 0; op < kSysbenchOp_MaxIdx; op++)
+    {
+        mtu_sysbench_stat_print(op, &s_sysbenchStat[op]);
+    }
+    if (computeRounds)
+    {
+        printf("Compute checksum: 0x%x\r\n", checksum);
+    }
+
+    return kStatus_Success;
+}
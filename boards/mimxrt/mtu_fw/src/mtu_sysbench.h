@@ -0,0 +1,49 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _MTU_SYSBENCH_H_
+#define _MTU_SYSBENCH_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "fsl_common.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+//! @brief Transfer size range, each operation picks a power of 2 size in it.
+#define MTU_SYSBENCH_MIN_BLOCK_SIZE       (4)
+#define MTU_SYSBENCH_MAX_BLOCK_SIZE       (4096)
+
+//! @brief Defaults if they are not given by perf test packet.
+#define MTU_SYSBENCH_DEFAULT_OPERATIONS   (100000)
+#define MTU_SYSBENCH_DEFAULT_READ_PERCENT (70)
+
+//! @brief Read percent that issues writes only, as 0 selects the default mix.
+#define MTU_SYSBENCH_READ_PERCENT_NONE    (0xFF)
+
+//! @brief Latency histogram has log2 buckets of CPU cycles, last one collects all above.
+#define MTU_SYSBENCH_HIST_BUCKETS         (24)
+
+//! @brief Operation types of mixed workload.
+enum _sysbench_ops
+{
+    kSysbenchOp_Read    = 0x00,
+    kSysbenchOp_Write   = 0x01,
+    kSysbenchOp_Compute = 0x02,
+    kSysbenchOp_MaxIdx,
+};
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+status_t mtu_sysbench_run(uint32_t operations, uint8_t readPercent, uint8_t computeRounds,
+                          uint32_t maxBlockSize, uint32_t memStart, uint32_t memSize);
+
+#endif /* _MTU_SYSBENCH_H_ */
@@ -30,4 +30,18 @@ void     mtu_life_timer_deinit(void);
 
 uint64_t mtu_life_timer_clock(void);
 
+void     mtu_cycle_timer_init(void);
+
+void     mtu_cycle_timer_deinit(void);
+
+void     mtu_cycle_timer_ensure_running(void);
+
+uint64_t mtu_cycle_timer_clock(void);
+
+uint32_t mtu_cycle_timer_count(void);
+
+void     mtu_cycle_timer_update(void);
+
+uint32_t mtu_cycle_timer_clocks_per_sec(void);
+
 #endif /* __MTU_TIMER__ */
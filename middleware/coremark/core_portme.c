@@ -0,0 +1,223 @@
+/*
+Copyright 2018 Embedded Microprocessor Benchmark Consortium (EEMBC)
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+Original Author: Shay Gal-on
+*/
+#include "coremark.h"
+#include "mtu.h"
+
+/* Kernel objects are collected into MtuCoremarkCode block by linker file, so
+   that the whole block can be copied to the memory under test. */
+#if (defined(__ICCARM__)) // IAR
+#pragma section = "MtuCoremarkCode"
+#define COREMARK_CODE_START ((uint32_t)__section_begin("MtuCoremarkCode"))
+#define COREMARK_CODE_SIZE  ((uint32_t)__section_end("MtuCoremarkCode") - COREMARK_CODE_START)
+#else
+#define COREMARK_CODE_START (0)
+#define COREMARK_CODE_SIZE  (0)
+#endif
+
+#if VALIDATION_RUN
+volatile ee_s32 seed1_volatile = 0x3415;
+volatile ee_s32 seed2_volatile = 0x3415;
+volatile ee_s32 seed3_volatile = 0x66;
+#endif
+#if PERFORMANCE_RUN || !(VALIDATION_RUN || PROFILE_RUN)
+volatile ee_s32 seed1_volatile = 0x0;
+volatile ee_s32 seed2_volatile = 0x0;
+volatile ee_s32 seed3_volatile = 0x66;
+#endif
+#if PROFILE_RUN
+volatile ee_s32 seed1_volatile = 0x8;
+volatile ee_s32 seed2_volatile = 0x8;
+volatile ee_s32 seed3_volatile = 0x8;
+#endif
+volatile ee_s32 seed4_volatile = 0;
+volatile ee_s32 seed5_volatile = 0;
+
+/* Porting : Timing functions
+        DWT cycle counter is used as timebase, it is extended to 64bit by
+   mtu_perf timebase task.
+*/
+#define GETMYTIME(_t)              (*_t = mtu_perf_timebase_clock())
+#define MYTIMEDIFF(fin, ini)       ((fin) - (ini))
+#define EE_TICKS_PER_SEC           (mtu_cycle_timer_clocks_per_sec())
+
+/** Define Host specific (POSIX), or target specific global time variables. */
+static CORETIMETYPE start_time_val, stop_time_val;
+
+/* Function : start_time
+        This function will be called right before starting the timed portion of
+   the benchmark.
+
+        Implementation may be capturing a system timer (as implemented in the
+   example code) or zeroing some system parameters - e.g. setting the cpu clocks
+   cycles to 0.
+*/
+void
+start_time(void)
+{
+    GETMYTIME(&start_time_val);
+}
+/* Function : stop_time
+        This function will be called right after ending the timed portion of the
+   benchmark.
+
+        Implementation may be capturing a system timer (as implemented in the
+   example code) or other system parameters - e.g. reading the current value of
+   cpu cycles counter.
+*/
+void
+stop_time(void)
+{
+    GETMYTIME(&stop_time_val);
+}
+/* Function : get_time
+        Return an abstract "ticks" number that signifies time on the system.
+
+        Actual value returned may be cpu cycles, milliseconds or any other
+   value, as long as it can be converted to seconds by <time_in_secs>. This
+   methodology is taken to accommodate any hardware or simulated platform. The
+   sample implementation returns millisecs by default, and the resolution is
+   controlled by <TIMER_RES_DIVIDER>
+*/
+CORE_TICKS
+get_time(void)
+{
+    CORE_TICKS elapsed
+        = (CORE_TICKS)(MYTIMEDIFF(stop_time_val, start_time_val));
+    return elapsed;
+}
+/* Function : time_in_secs
+        Convert the value returned by get_time to seconds.
+
+        The <secs_ret> type is used to accommodate systems with no support for
+   floating point. Default implementation implemented by the EE_TICKS_PER_SEC
+   macro above.
+*/
+secs_ret
+time_in_secs(CORE_TICKS ticks)
+{
+    secs_ret retval = ((secs_ret)ticks) / (secs_ret)EE_TICKS_PER_SEC;
+    return retval;
+}
+
+ee_u32 default_num_contexts = 1;
+
+/* Run parameters from perf test packet and resulting code/data layout */
+static ee_u8             s_coremarkMemPlacement;
+static ee_u32            s_coremarkMemStart;
+static ee_u32            s_coremarkMemSize;
+static perf_mem_layout_t s_coremarkMemLayout;
+
+/* Default data block, it is in DTCM */
+static ee_u32 s_coremarkDataBlock[(TOTAL_DATA_SIZE + 3) / 4];
+
+static const char *const s_coremarkMemLocation[kPerfMemPlacement_MaxIdx][kPerfMemPlacement_MaxIdx] = {
+    {"Code in TCM, Data in TCM", "Code in TCM, Data in OCRAM", "Code in TCM, Data in ExtMem"},
+    {"Code in OCRAM, Data in TCM", "Code in OCRAM, Data in OCRAM", "Code in OCRAM, Data in ExtMem"},
+    {"Code in ExtMem, Data in TCM", "Code in ExtMem, Data in OCRAM", "Code in ExtMem, Data in ExtMem"},
+};
+
+void
+portable_config(ee_u32 iterations, ee_u8 mem_placement, ee_u32 mem_start, ee_u32 mem_size)
+{
+    /* 0 means iterations are determined automatically (~10s run) */
+    seed4_volatile         = iterations;
+    s_coremarkMemPlacement = mem_placement;
+    s_coremarkMemStart     = mem_start;
+    s_coremarkMemSize      = mem_size;
+}
+
+/* Function : portable_malloc
+        Provide the data block from the memory selected by perf test packet.
+*/
+void *
+portable_malloc(ee_size_t size)
+{
+    if (s_coremarkMemLayout.dataStart)
+    {
+        return (void *)s_coremarkMemLayout.dataStart;
+    }
+    if (size > sizeof(s_coremarkDataBlock))
+    {
+        return NULL;
+    }
+    return (void *)s_coremarkDataBlock;
+}
+/* Function : portable_free
+        Nothing to free, data block is static or provided by memory under test.
+*/
+void
+portable_free(void *p)
+{
+    p = NULL;
+}
+
+const char *
+portable_mem_location(void)
+{
+    return s_coremarkMemLocation[s_coremarkMemLayout.codePlacement][s_coremarkMemLayout.dataPlacement];
+}
+
+/* Function : portable_init
+        Target specific initialization code
+        Test for some common mistakes.
+*/
+void
+portable_init(core_portable *p, int *argc, char *argv[])
+{
+    p->portable_id = 0;
+    if (sizeof(ee_ptr_int) != sizeof(ee_u8 *))
+    {
+        ee_printf(
+            "ERROR! Please define ee_ptr_int to a type that holds a "
+            "pointer!\n");
+        return;
+    }
+    if (sizeof(ee_u32) != 4)
+    {
+        ee_printf("ERROR! Please define ee_u32 to a 32b unsigned type!\n");
+        return;
+    }
+
+    printf("Arg List: iterations=%d, memPlacement=0x%x, memStart=0x%x, memSize=0x%x.\n",
+           seed4_volatile, s_coremarkMemPlacement, s_coremarkMemStart, s_coremarkMemSize);
+    memset(&s_coremarkMemLayout, 0, sizeof(s_coremarkMemLayout));
+    s_coremarkMemLayout.codeStart = COREMARK_CODE_START;
+    s_coremarkMemLayout.codeSize  = COREMARK_CODE_SIZE;
+    s_coremarkMemLayout.dataSize  = TOTAL_DATA_SIZE;
+    if (mtu_perf_mem_setup(s_coremarkMemPlacement, s_coremarkMemStart, s_coremarkMemSize, &s_coremarkMemLayout) != kStatus_Success)
+    {
+        memset(&s_coremarkMemLayout, 0, sizeof(s_coremarkMemLayout));
+        return;
+    }
+    mtu_perf_mem_print(&s_coremarkMemLayout);
+    mtu_perf_timebase_start();
+
+    p->portable_id = 1;
+}
+/* Function : portable_fini
+        Target specific final code
+*/
+void
+portable_fini(core_portable *p)
+{
+    p->portable_id = 0;
+
+    mtu_perf_timebase_stop();
+    mtu_perf_mem_restore();
+    memset(&s_coremarkMemLayout, 0, sizeof(s_coremarkMemLayout));
+}
@@ -0,0 +1,174 @@
+/*
+ ****************************************************************************
+ *
+ *                   "DHRYSTONE" Benchmark Program
+ *                   -----------------------------
+ *
+ *  Version:    C, Version 2.1
+ *
+ *  File:       dhry.h (part 1 of 3)
+ *
+ *  Date:       May 25, 1988
+ *
+ *  Author:     Reinhold P. Weicker
+ *                      Siemens AG, AUT E 51
+ *                      Postfach 3220
+ *                      8520 Erlangen
+ *                      Germany (West)
+ *                              Phone:  [+49]-9131-7-20330
+ *                                      (8-17 Central European Time)
+ *                              Usenet: ..!mcsun!unido!estevax!weicker
+ *
+ *              Original Version (in Ada) published in
+ *              "Communications of the ACM" vol. 27., no. 10 (Oct. 1984),
+ *              pp. 1013 - 1030, together with the statistics
+ *              on which the distribution of statements etc. is based.
+ *
+ *              In this C version, the following C library functions are used:
+ *              - strcpy, strcmp (inside the measurement loop)
+ *              - printf, scanf (outside the measurement loop)
+ *              In addition, Berkeley UNIX system calls "times ()" or "time ()"
+ *              are used for execution time measurement. For measurements
+ *              on other systems, these calls have to be changed.
+ *
+ *  Collection of Results:
+ *              Reinhold Weicker (address see above) and
+ *
+ *              Rick Richardson
+ *              PC Research. Inc.
+ *              94 Apple Orchard Drive
+ *              Tinton Falls, NJ 07724
+ *                      Phone:  (201) 389-8963 (9-17 EST)
+ *                      Usenet: ...!uunet!pcrat!rick
+ *
+ *      Please send results to Rick Richardson and/or Reinhold Weicker.
+ *      Complete information should be given on hardware and software used.
+ *      Hardware information includes: Machine type, CPU, type and size
+ *      of caches; for microprocessors: clock frequency, memory speed
+ *      (number of wait states).
+ *      Software information includes: Compiler (and runtime library)
+ *      manufacturer and version, compilation switches, OS version.
+ *      The Operating System version may give an indication about the
+ *      compiler; Dhrystone itself performs no OS calls in the measurement loop.
+ *
+ *      The complete output generated by the program should be mailed
+ *      such that at least some checks for correctness can be made.
+ *
+ ***************************************************************************
+ *
+ *  MTU port:
+ *      - ANSI C prototypes instead of K&R declarations.
+ *      - Measurement loop is moved from main into Proc_0, so the code block
+ *        (dhry_1.o and dhry_2.o) can be executed from a relocated copy.
+ *        Library calls are not reachable from a relocated copy, so strcpy,
+ *        strcmp and struct assignment use local equivalents.
+ *      - Timing is done by DWT cycle counter.
+ *
+ ***************************************************************************
+ */
+
+#ifndef __DHRY_H__
+#define __DHRY_H__
+
+#include "dhrystone.h"
+
+/* Compiler and system dependent definitions: */
+
+#define Too_Small_Time 2
+                /* Measurements should last at least 2 seconds */
+
+#define NOSTRUCTASSIGN
+#ifdef  NOSTRUCTASSIGN
+#define structassign(d, s)      Dhry_Memcpy (&(d), &(s), sizeof(d))
+#else
+#define structassign(d, s)      d = s
+#endif
+
+#ifdef  NOENUM
+#define Ident_1 0
+#define Ident_2 1
+#define Ident_3 2
+#define Ident_4 3
+#define Ident_5 4
+  typedef int   Enumeration;
+#else
+  typedef       enum    {Ident_1, Ident_2, Ident_3, Ident_4, Ident_5}
+                Enumeration;
+#endif
+        /* for boolean and enumeration types in Ada, Pascal */
+
+/* General definitions: */
+
+#define Null 0
+                /* Value of a Null pointer */
+#ifndef true
+#define true  1
+#endif
+#ifndef false
+#define false 0
+#endif
+
+typedef int     One_Thirty;
+typedef int     One_Fifty;
+typedef char    Capital_Letter;
+typedef int     Boolean;
+typedef char    Str_30 [31];
+typedef int     Arr_1_Dim [50];
+typedef int     Arr_2_Dim [50] [50];
+
+typedef struct record
+    {
+    struct record *Ptr_Comp;
+    Enumeration    Discr;
+    union {
+          struct {
+                  Enumeration Enum_Comp;
+                  int         Int_Comp;
+                  char        Str_Comp [31];
+                  } var_1;
+          struct {
+                  Enumeration E_Comp_2;
+                  char        Str_2_Comp [31];
+                  } var_2;
+          struct {
+                  char        Ch_1_Comp;
+                  char        Ch_2_Comp;
+                  } var_3;
+          } variant;
+      } Rec_Type, *Rec_Pointer;
+
+/* Locals of the measurement loop, reported after the run */
+typedef struct
+    {
+    One_Fifty       Int_1_Loc;
+    One_Fifty       Int_2_Loc;
+    One_Fifty       Int_3_Loc;
+    Enumeration     Enum_Loc;
+    Str_30          Str_1_Loc;
+    Str_30          Str_2_Loc;
+    } Loc_Type;
+
+/* Procedures and functions */
+
+void        Proc_0 (int Number_Of_Runs, Loc_Type *Loc_Ref);
+void        Proc_1 (Rec_Pointer Ptr_Val_Par);
+void        Proc_2 (One_Fifty *Int_Par_Ref);
+void        Proc_3 (Rec_Pointer *Ptr_Ref_Par);
+void        Proc_4 (void);
+void        Proc_5 (void);
+void        Proc_6 (Enumeration Enum_Val_Par, Enumeration *Enum_Ref_Par);
+void        Proc_7 (One_Fifty Int_1_Par_Val, One_Fifty Int_2_Par_Val,
+                    One_Fifty *Int_Par_Ref);
+void        Proc_8 (Arr_1_Dim Arr_1_Par_Ref, Arr_2_Dim Arr_2_Par_Ref,
+                    int Int_1_Par_Val, int Int_2_Par_Val);
+Enumeration Func_1 (Capital_Letter Ch_1_Par_Val, Capital_Letter Ch_2_Par_Val);
+Boolean     Func_2 (Str_30 Str_1_Par_Ref, Str_30 Str_2_Par_Ref);
+Boolean     Func_3 (Enumeration Enum_Par_Val);
+
+/* Library replacements, they stay in the relocatable code block */
+
+char       *Dhry_Strcpy (char *Dst, const char *Src);
+int         Dhry_Strcmp (const char *Str_1, const char *Str_2);
+void       *Dhry_Memcpy (void *Dst, const void *Src, unsigned int Size);
+
+#endif /* __DHRY_H__ */
@@ -0,0 +1,421 @@
+/*
+ ****************************************************************************
+ *
+ *                   "DHRYSTONE" Benchmark Program
+ *                   -----------------------------
+ *
+ *  Version:    C, Version 2.1
+ *
+ *  File:       dhry_1.c (part 2 of 3)
+ *
+ *  Date:       May 25, 1988
+ *
+ *  Author:     Reinhold P. Weicker
+ *
+ ****************************************************************************
+ */
+
+#include "dhry.h"
+
+/* Procedures in this file and dhry_2.c are collected into MtuDhrystoneCode
+   block by linker file, so that the whole block can be copied to the memory
+   under test. */
+#if (defined(__ICCARM__)) // IAR
+#pragma section = "MtuDhrystoneCode"
+#define DHRY_CODE_START ((uint32_t)__section_begin("MtuDhrystoneCode"))
+#define DHRY_CODE_SIZE  ((uint32_t)__section_end("MtuDhrystoneCode") - DHRY_CODE_START)
+#else
+#define DHRY_CODE_START (0)
+#define DHRY_CODE_SIZE  (0)
+#endif
+
+/* Global Variables: */
+
+Rec_Pointer     Ptr_Glob,
+                Next_Ptr_Glob;
+int             Int_Glob;
+Boolean         Bool_Glob;
+char            Ch_1_Glob,
+                Ch_2_Glob;
+/* Port: arrays are referenced by pointer, they are either in the default
+   data block (DTCM) or carved from the memory under test */
+int            *Arr_1_Glob;
+int           (*Arr_2_Glob) [50];
+
+#ifndef REG
+        Boolean Reg = false;
+#define REG
+        /* REG becomes defined as empty */
+        /* i.e. no register variables   */
+#else
+        Boolean Reg = true;
+#endif
+
+#define DHRY_DATA_SIZE  (2 * sizeof (Rec_Type) + sizeof (Arr_1_Dim) + sizeof (Arr_2_Dim))
+
+/* Default data block, it is in DTCM */
+static uint32_t         s_dhryDataBlock [DHRY_DATA_SIZE / 4];
+
+static const char *const s_dhryMemLocation[kPerfMemPlacement_MaxIdx][kPerfMemPlacement_MaxIdx] = {
+    {"Code in TCM, Data in TCM", "Code in TCM, Data in OCRAM", "Code in TCM, Data in ExtMem"},
+    {"Code in OCRAM, Data in TCM", "Code in OCRAM, Data in OCRAM", "Code in OCRAM, Data in ExtMem"},
+    {"Code in ExtMem, Data in TCM", "Code in ExtMem, Data in OCRAM", "Code in ExtMem, Data in ExtMem"},
+};
+
+static void Dhry_Data_Init (uint32_t Data_Start)
+/**********************************************/
+    /* Data_Start == 0 means default data block is used */
+{
+  if (! Data_Start)
+    Data_Start = (uint32_t) s_dhryDataBlock;
+  memset ((void *) Data_Start, 0, DHRY_DATA_SIZE);
+
+  Next_Ptr_Glob = (Rec_Pointer) Data_Start;
+  Ptr_Glob = Next_Ptr_Glob + 1;
+  Arr_1_Glob = (int *) (Ptr_Glob + 1);
+  Arr_2_Glob = (int (*) [50]) (Arr_1_Glob + 50);
+}
+
+//main ()
+int dhrystone_main (uint32_t iterations, uint8_t mem_placement, uint32_t mem_start, uint32_t mem_size)
+/*****/
+
+  /* main program, corresponds to procedures        */
+  /* Main and Proc_0 in the Ada version             */
+{
+        Loc_Type        Loc;
+        int             Number_Of_Runs;
+        int             Error_Count = 0;
+        perf_mem_layout_t Mem_Layout;
+        uint64_t        Begin_Time,
+                        End_Time,
+                        User_Time;
+        float           User_Secs,
+                        Microseconds,
+                        Dhrystones_Per_Second,
+                        Dhrystone_Mips;
+        void          (*Proc_0_Exec) (int, Loc_Type *);
+
+  Number_Of_Runs = iterations ? (int) iterations : DHRY_DEFAULT_NUMBER_OF_RUNS;
+  printf ("Arg List: iterations=%d, memPlacement=0x%x, memStart=0x%x, memSize=0x%x.\n",
+          iterations, mem_placement, mem_start, mem_size);
+
+  memset (&Mem_Layout, 0, sizeof (Mem_Layout));
+  Mem_Layout.codeStart = DHRY_CODE_START;
+  Mem_Layout.codeSize  = DHRY_CODE_SIZE;
+  Mem_Layout.dataSize  = DHRY_DATA_SIZE;
+  if (mtu_perf_mem_setup (mem_placement, mem_start, mem_size, &Mem_Layout) != kStatus_Success)
+  {
+    return -1;
+  }
+  mtu_perf_mem_print (&Mem_Layout);
+
+  /* Initializations */
+
+  Dhry_Data_Init (Mem_Layout.dataStart);
+
+  Ptr_Glob->Ptr_Comp                    = Next_Ptr_Glob;
+  Ptr_Glob->Discr                       = Ident_1;
+  Ptr_Glob->variant.var_1.Enum_Comp     = Ident_3;
+  Ptr_Glob->variant.var_1.Int_Comp      = 40;
+  Dhry_Strcpy (Ptr_Glob->variant.var_1.Str_Comp,
+          "DHRYSTONE PROGRAM, SOME STRING");
+  Dhry_Strcpy (Loc.Str_1_Loc, "DHRYSTONE PROGRAM, 1'ST STRING");
+
+  Arr_2_Glob [8][7] = 10;
+        /* Was missing in published program. Without this statement,    */
+        /* Arr_2_Glob [8][7] would have an undefined value.             */
+        /* Warning: With 16-Bit processors and Number_Of_Runs > 32000,  */
+        /* overflow may occur for this array element.                   */
+
+  printf ("\n");
+  printf ("Dhrystone Benchmark, Version 2.1 (Language: C)\n");
+  printf ("\n");
+  if (Reg)
+  {
+    printf ("Program compiled with 'register' attribute\n");
+    printf ("\n");
+  }
+  else
+  {
+    printf ("Program compiled without 'register' attribute\n");
+    printf ("\n");
+  }
+
+  printf ("Execution starts, %d runs through Dhrystone\n", Number_Of_Runs);
+
+  /* Port: measurement loop is executed from where code block is loaded */
+  Proc_0_Exec = (void (*) (int, Loc_Type *)) mtu_perf_code_addr ((uint32_t) Proc_0);
+
+  mtu_perf_timebase_start ();
+
+  /***************/
+  /* Start timer */
+  /***************/
+
+  Begin_Time = mtu_perf_timebase_clock ();
+
+  Proc_0_Exec (Number_Of_Runs, &Loc);
+
+  /**************/
+  /* Stop timer */
+  /**************/
+
+  End_Time = mtu_perf_timebase_clock ();
+
+  mtu_perf_timebase_stop ();
+  mtu_perf_mem_restore ();
+
+  printf ("Execution ends\n");
+  printf ("\n");
+  printf ("Final values of the variables used in the benchmark:\n");
+  printf ("\n");
+  printf ("Int_Glob:            %d\n", Int_Glob);
+  printf ("        should be:   %d\n", 5);
+  printf ("Bool_Glob:           %d\n", Bool_Glob);
+  printf ("        should be:   %d\n", 1);
+  printf ("Ch_1_Glob:           %c\n", Ch_1_Glob);
+  printf ("        should be:   %c\n", 'A');
+  printf ("Ch_2_Glob:           %c\n", Ch_2_Glob);
+  printf ("        should be:   %c\n", 'B');
+  printf ("Arr_1_Glob[8]:       %d\n", Arr_1_Glob[8]);
+  printf ("        should be:   %d\n", 7);
+  printf ("Arr_2_Glob[8][7]:    %d\n", Arr_2_Glob[8][7]);
+  printf ("        should be:   Number_Of_Runs + 10\n");
+  printf ("Ptr_Glob->\n");
+  printf ("  Ptr_Comp:          %d\n", (int) Ptr_Glob->Ptr_Comp);
+  printf ("        should be:   (implementation-dependent)\n");
+  printf ("  Discr:             %d\n", Ptr_Glob->Discr);
+  printf ("        should be:   %d\n", 0);
+  printf ("  Enum_Comp:         %d\n", Ptr_Glob->variant.var_1.Enum_Comp);
+  printf ("        should be:   %d\n", 2);
+  printf ("  Int_Comp:          %d\n", Ptr_Glob->variant.var_1.Int_Comp);
+  printf ("        should be:   %d\n", 17);
+  printf ("  Str_Comp:          %s\n", Ptr_Glob->variant.var_1.Str_Comp);
+  printf ("        should be:   DHRYSTONE PROGRAM, SOME STRING\n");
+  printf ("Next_Ptr_Glob->\n");
+  printf ("  Ptr_Comp:          %d\n", (int) Next_Ptr_Glob->Ptr_Comp);
+  printf ("        should be:   (implementation-dependent), same as above\n");
+  printf ("  Discr:             %d\n", Next_Ptr_Glob->Discr);
+  printf ("        should be:   %d\n", 0);
+  printf ("  Enum_Comp:         %d\n", Next_Ptr_Glob->variant.var_1.Enum_Comp);
+  printf ("        should be:   %d\n", 1);
+  printf ("  Int_Comp:          %d\n", Next_Ptr_Glob->variant.var_1.Int_Comp);
+  printf ("        should be:   %d\n", 18);
+  printf ("  Str_Comp:          %s\n",
+                                Next_Ptr_Glob->variant.var_1.Str_Comp);
+  printf ("        should be:   DHRYSTONE PROGRAM, SOME STRING\n");
+  printf ("Int_1_Loc:           %d\n", Loc.Int_1_Loc);
+  printf ("        should be:   %d\n", 5);
+  printf ("Int_2_Loc:           %d\n", Loc.Int_2_Loc);
+  printf ("        should be:   %d\n", 13);
+  printf ("Int_3_Loc:           %d\n", Loc.Int_3_Loc);
+  printf ("        should be:   %d\n", 7);
+  printf ("Enum_Loc:            %d\n", Loc.Enum_Loc);
+  printf ("        should be:   %d\n", 1);
+  printf ("Str_1_Loc:           %s\n", Loc.Str_1_Loc);
+  printf ("        should be:   DHRYSTONE PROGRAM, 1'ST STRING\n");
+  printf ("Str_2_Loc:           %s\n", Loc.Str_2_Loc);
+  printf ("        should be:   DHRYSTONE PROGRAM, 2'ND STRING\n");
+  printf ("\n");
+
+  /* Port: check the final values, a wrong result invalidates the score */
+  Error_Count += (Int_Glob != 5);
+  Error_Count += (Bool_Glob != 1);
+  Error_Count += (Ch_1_Glob != 'A') + (Ch_2_Glob != 'B');
+  Error_Count += (Arr_1_Glob[8] != 7);
+  Error_Count += (Arr_2_Glob[8][7] != Number_Of_Runs + 10);
+  Error_Count += (Ptr_Glob->Discr != 0) + (Ptr_Glob->variant.var_1.Enum_Comp != 2) +
+                 (Ptr_Glob->variant.var_1.Int_Comp != 17);
+  Error_Count += (Next_Ptr_Glob->Discr != 0) + (Next_Ptr_Glob->variant.var_1.Enum_Comp != 1) +
+                 (Next_Ptr_Glob->variant.var_1.Int_Comp != 18);
+  Error_Count += (Loc.Int_1_Loc != 5) + (Loc.Int_2_Loc != 13) + (Loc.Int_3_Loc != 7) + (Loc.Enum_Loc != 1);
+  Error_Count += (Dhry_Strcmp (Loc.Str_2_Loc, "DHRYSTONE PROGRAM, 2'ND STRING") != 0);
+
+  User_Time = End_Time - Begin_Time;
+  User_Secs = (float) User_Time / (float) mtu_cycle_timer_clocks_per_sec ();
+
+  if (User_Secs < Too_Small_Time)
+  {
+    printf ("Measured time too small to obtain meaningful results\n");
+    printf ("Please increase number of runs\n");
+    printf ("\n");
+  }
+
+  Microseconds = User_Secs * 1000000.0f / (float) Number_Of_Runs;
+  Dhrystones_Per_Second = (float) Number_Of_Runs / User_Secs;
+  Dhrystone_Mips = Dhrystones_Per_Second / (float) DHRY_VAX_DHRYSTONES_PER_SEC;
+
+  printf ("Memory location                            %s\n",
+          s_dhryMemLocation [Mem_Layout.codePlacement][Mem_Layout.dataPlacement]);
+  printf ("Total cycles                               %llu\n", User_Time);
+  printf ("Cycles for one run through Dhrystone:      %.1f\n", (float) User_Time / (float) Number_Of_Runs);
+  printf ("Microseconds for one run through Dhrystone: %.3f\n", Microseconds);
+  printf ("Dhrystones per Second:                     %.1f\n", Dhrystones_Per_Second);
+  printf ("DMIPS:                                     %.2f\n", Dhrystone_Mips);
+  printf ("DMIPS/MHz:                                 %.3f\n",
+          Dhrystone_Mips * 1000000.0f / (float) mtu_cycle_timer_clocks_per_sec ());
+  if (Error_Count)
+  {
+    printf ("Errors detected in final values: %d, results are not valid!\n", Error_Count);
+  }
+  printf ("\n");
+
+  return Error_Count ? -1 : 0;
+}
+
+
+void Proc_0 (int Number_Of_Runs, Loc_Type *Loc_Ref)
+/*************************************************/
+    /* Port: measurement loop of main, it is placed in relocatable code */
+    /* block, locals are kept local and only reported at the end        */
+{
+        One_Fifty       Int_1_Loc;
+  REG   One_Fifty       Int_2_Loc;
+        One_Fifty       Int_3_Loc;
+  REG   char            Ch_Index;
+        Enumeration     Enum_Loc;
+        Str_30          Str_1_Loc;
+        Str_30          Str_2_Loc;
+  REG   int             Run_Index;
+
+  Dhry_Strcpy (Str_1_Loc, Loc_Ref->Str_1_Loc);
+
+  for (Run_Index = 1; Run_Index <= Number_Of_Runs; ++Run_Index)
+  {
+
+    Proc_5();
+    Proc_4();
+      /* Ch_1_Glob == 'A', Ch_2_Glob == 'B', Bool_Glob == true */
+    Int_1_Loc = 2;
+    Int_2_Loc = 3;
+    Dhry_Strcpy (Str_2_Loc, "DHRYSTONE PROGRAM, 2'ND STRING");
+    Enum_Loc = Ident_2;
+    Bool_Glob = ! Func_2 (Str_1_Loc, Str_2_Loc);
+      /* Bool_Glob == 1 */
+    while (Int_1_Loc < Int_2_Loc)  /* loop body executed once */
+    {
+      Int_3_Loc = 5 * Int_1_Loc - Int_2_Loc;
+        /* Int_3_Loc == 7 */
+      Proc_7 (Int_1_Loc, Int_2_Loc, &Int_3_Loc);
+        /* Int_3_Loc == 7 */
+      Int_1_Loc += 1;
+    } /* while */
+      /* Int_1_Loc == 3, Int_2_Loc == 3, Int_3_Loc == 7 */
+    Proc_8 (Arr_1_Glob, Arr_2_Glob, Int_1_Loc, Int_3_Loc);
+      /* Int_Glob == 5 */
+    Proc_1 (Ptr_Glob);
+    for (Ch_Index = 'A'; Ch_Index <= Ch_2_Glob; ++Ch_Index)
+                             /* loop body executed twice */
+    {
+      if (Enum_Loc == Func_1 (Ch_Index, 'C'))
+          /* then, not executed */
+        {
+        Proc_6 (Ident_1, &Enum_Loc);
+        Dhry_Strcpy (Str_2_Loc, "DHRYSTONE PROGRAM, 3'RD STRING");
+        Int_2_Loc = Run_Index;
+        Int_Glob = Run_Index;
+        }
+    }
+      /* Int_1_Loc == 3, Int_2_Loc == 3, Int_3_Loc == 7 */
+    Int_2_Loc = Int_2_Loc * Int_1_Loc;
+    Int_1_Loc = Int_2_Loc / Int_3_Loc;
+    Int_2_Loc = 7 * (Int_2_Loc - Int_3_Loc) - Int_1_Loc;
+      /* Int_1_Loc == 1, Int_2_Loc == 13, Int_3_Loc == 7 */
+    Proc_2 (&Int_1_Loc);
+      /* Int_1_Loc == 5 */
+
+  } /* loop "for Run_Index" */
+
+  Loc_Ref->Int_1_Loc = Int_1_Loc;
+  Loc_Ref->Int_2_Loc = Int_2_Loc;
+  Loc_Ref->Int_3_Loc = Int_3_Loc;
+  Loc_Ref->Enum_Loc = Enum_Loc;
+  Dhry_Strcpy (Loc_Ref->Str_2_Loc, Str_2_Loc);
+} /* Proc_0 */
+
+
+void Proc_1 (REG Rec_Pointer Ptr_Val_Par)
+/******************/
+    /* executed once */
+{
+  REG Rec_Pointer Next_Record = Ptr_Val_Par->Ptr_Comp;
+                                        /* == Ptr_Glob_Next */
+  /* Local variable, initialized with Ptr_Val_Par->Ptr_Comp,    */
+  /* corresponds to "rename" in Ada, "with" in Pascal           */
+
+  structassign (*Ptr_Val_Par->Ptr_Comp, *Ptr_Glob);
+  Ptr_Val_Par->variant.var_1.Int_Comp = 5;
+  Next_Record->variant.var_1.Int_Comp
+        = Ptr_Val_Par->variant.var_1.Int_Comp;
+  Next_Record->Ptr_Comp = Ptr_Val_Par->Ptr_Comp;
+  Proc_3 (&Next_Record->Ptr_Comp);
+    /* Ptr_Val_Par->Ptr_Comp->Ptr_Comp
+                        == Ptr_Glob->Ptr_Comp */
+  if (Next_Record->Discr == Ident_1)
+    /* then, executed */
+  {
+    Next_Record->variant.var_1.Int_Comp = 6;
+    Proc_6 (Ptr_Val_Par->variant.var_1.Enum_Comp,
+           &Next_Record->variant.var_1.Enum_Comp);
+    Next_Record->Ptr_Comp = Ptr_Glob->Ptr_Comp;
+    Proc_7 (Next_Record->variant.var_1.Int_Comp, 10,
+           &Next_Record->variant.var_1.Int_Comp);
+  }
+  else /* not executed */
+    structassign (*Ptr_Val_Par, *Ptr_Val_Par->Ptr_Comp);
+} /* Proc_1 */
+
+
+void Proc_2 (One_Fifty *Int_Par_Ref)
+/******************/
+    /* executed once */
+    /* *Int_Par_Ref == 1, becomes 4 */
+{
+  One_Fifty  Int_Loc;
+  Enumeration   Enum_Loc = Ident_2;
+
+  Int_Loc = *Int_Par_Ref + 10;
+  do /* executed once */
+    if (Ch_1_Glob == 'A')
+      /* then, executed */
+    {
+      Int_Loc -= 1;
+      *Int_Par_Ref = Int_Loc - Int_Glob;
+      Enum_Loc = Ident_1;
+    } /* if */
+  while (Enum_Loc != Ident_1); /* true */
+} /* Proc_2 */
+
+
+void Proc_3 (Rec_Pointer *Ptr_Ref_Par)
+/******************/
+    /* executed once */
+    /* Ptr_Ref_Par becomes Ptr_Glob */
+{
+  if (Ptr_Glob != Null)
+    /* then, executed */
+    *Ptr_Ref_Par = Ptr_Glob->Ptr_Comp;
+  Proc_7 (10, Int_Glob, &Ptr_Glob->variant.var_1.Int_Comp);
+} /* Proc_3 */
+
+
+void Proc_4 (void) /* without parameters */
+/*******/
+    /* executed once */
+{
+  Boolean Bool_Loc;
+
+  Bool_Loc = Ch_1_Glob == 'A';
+  Bool_Glob = Bool_Loc | Bool_Glob;
+  Ch_2_Glob = 'B';
+} /* Proc_4 */
+
+
+void Proc_5 (void) /* without parameters */
+/*******/
+    /* executed once */
+{
+  Ch_1_Glob = 'A';
+  Bool_Glob = false;
+} /* Proc_5 */
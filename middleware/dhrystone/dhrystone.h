@@ -0,0 +1,15 @@
+#ifndef __DHRYSTONE_H__
+#define __DHRYSTONE_H__
+
+#include "fsl_common.h"
+#include "mtu.h"
+
+/* Number of runs if it is not given by perf test packet */
+#define DHRY_DEFAULT_NUMBER_OF_RUNS (5000000)
+
+/* Reference machine (VAX 11/780) result, 1 DMIPS */
+#define DHRY_VAX_DHRYSTONES_PER_SEC (1757)
+
+int dhrystone_main(uint32_t iterations, uint8_t mem_placement, uint32_t mem_start, uint32_t mem_size);
+
+#endif // __DHRYSTONE_H__
@@ -82,13 +82,44 @@ int memtester_pagesize(void) {
 
 /* Function declarations */
 void memtester_usage(char *me);
+static ul memtester_cycles_to_ms(uint64_t cycles);
 
 /* Global vars - so tests have access to this information */
 int use_phys = 0;
 off_t physaddrbase = 0;
 extern int s_memtester_fail_stop;
+extern uint16_t s_memtester_test_mask;
+
+/* Per-test cycles and result bitmaps, bit i is tests[i], stuck address test
+   uses MEMTESTER_TEST_MASK_STUCK_ADDRESS */
+static uint64_t test_cycles[32];
+static ul test_pass_map, test_fail_map;
 
 /* Function definitions */
+/* Expand 16-bit packet mask into the mask of tests[] index bits */
+static ul memtester_expand_test_mask(uint16_t mask) {
+    ul testmask;
+
+    if (!mask) {
+        return 0;
+    }
+    testmask = mask & MEMTESTER_PACKET_MASK_TESTS;
+    if (mask & MEMTESTER_PACKET_MASK_WALKING_BITS) {
+        testmask |= (ul)3 << 13; /* Walking Ones, Walking Zeroes */
+    }
+    if (mask & MEMTESTER_PACKET_MASK_NARROW_WRITES) {
+        testmask |= (ul)3 << 15; /* 8-bit Writes, 16-bit Writes */
+    }
+    if (mask & MEMTESTER_PACKET_MASK_STUCK_ADDRESS) {
+        testmask |= MEMTESTER_TEST_MASK_STUCK_ADDRESS;
+    }
+    return testmask;
+}
+
+static ul memtester_cycles_to_ms(uint64_t cycles) {
+    return (ul) (cycles * 1000 / mtu_cycle_timer_clocks_per_sec());
+}
+
 void memtester_usage(char *me) {
     printf("\n"
             "Usage: %s [-p physaddrbase [-d device]] <mem>[B|K|M|G] [loops]\n",
@@ -125,7 +156,11 @@ int memtester_main(ul phystestbase, ul wantraw, char *memsuffix, ul loops, ul pa
     int device_specified = 0;
     char *env_testmask = 0;
     */
-    ul testmask = 0;
+    ul testmask = memtester_expand_test_mask(s_memtester_test_mask);
+    ul testbit;
+    ul seed;
+    int r;
+    uint64_t test_elapsed;
 
     physaddrbase = phystestbase;
     printf("Arg List: phystestbase=0x%x, wantraw=0x%x, pagesize=0x%x, loops=%d, fail_stop=%d.\n", (uint32_t)phystestbase, (uint32_t)wantraw, pagesize, loops, s_memtester_fail_stop);
@@ -133,6 +168,9 @@ int memtester_main(ul phystestbase, ul wantraw, char *memsuffix, ul loops, ul pa
     printf("Copyright (C) 2001-2020 Charles Cazabon.\n");
     printf("Licensed under the GNU General Public License version 2 (only).\n");
     printf("\n");
+    if (testmask) {
+        printf("using testmask 0x%x (packet mask 0x%04x)\n", testmask, s_memtester_test_mask);
+    }
 
 #if 0
     check_posix_system();
@@ -388,32 +426,59 @@ int memtester_main(ul phystestbase, ul wantraw, char *memsuffix, ul loops, ul pa
     bufa = (ulv *) aligned;
     bufb = (ulv *) ((size_t) aligned + halflen);
 
+    memset(test_cycles, 0, sizeof(test_cycles));
+    test_pass_map = test_fail_map = 0;
+    /* Cycle counter still holds the length of previous timed test, so it is
+       a cheap varying seed; it must be taken before timer init clears it. */
+    rand_seed(MEMTESTER_RANDOM_SEED ? MEMTESTER_RANDOM_SEED : mtu_cycle_timer_count());
+    seed = rand_state;
+    printf("random seed 0x%08x\n", seed);
+    mtu_perf_timebase_start();
+
     for(loop=1; ((!loops) || loop <= loops); loop++) {
         printf("Loop %d", loop);
         if (loops) {
             printf("/%d", loops);
         }
         printf(":\n");
-        printf("  %s: ", "Stuck Address");
-        if (!test_stuck_address(aligned, bufsize / sizeof(ul))) {
-             printf("ok\n");
-        } else {
-            exit_code |= EXIT_FAIL_ADDRESSLINES;
-            if (s_memtester_fail_stop)
-              break;
+        if (!testmask || (testmask & MEMTESTER_TEST_MASK_STUCK_ADDRESS)) {
+            testbit = MEMTESTER_TEST_MASK_STUCK_ADDRESS;
+            printf("  %s: ", "Stuck Address");
+            test_elapsed = mtu_cycle_timer_clock();
+            r = test_stuck_address(aligned, bufsize / sizeof(ul));
+            test_elapsed = mtu_cycle_timer_clock() - test_elapsed;
+            test_cycles[31] += test_elapsed;
+            if (!r) {
+                 test_pass_map |= testbit;
+                 printf("ok (%d ms)\n", memtester_cycles_to_ms(test_elapsed));
+            } else {
+                test_fail_map |= testbit;
+                exit_code |= EXIT_FAIL_ADDRESSLINES;
+                if (s_memtester_fail_stop)
+                  break;
+            }
         }
         for (i=0;;i++) {
             if (!tests[i].name) break;
             /* If using a custom testmask, only run this test if the
                bit corresponding to this test was set by the user.
              */
-            if (testmask && (!((1 << i) & testmask))) {
+            testbit = (ul)1 << i;
+            if (testmask && (!(testbit & testmask))) {
                 continue;
             }
             printf("  %s: ", tests[i].name);
-            if (!tests[i].fp(bufa, bufb, count)) {
-                printf("ok\n");
+            fail_summary_reset();
+            test_elapsed = mtu_cycle_timer_clock();
+            r = tests[i].fp(bufa, bufb, count);
+            test_elapsed = mtu_cycle_timer_clock() - test_elapsed;
+            test_cycles[i] += test_elapsed;
+            if (!r) {
+                test_pass_map |= testbit;
+                printf("ok (%d ms)\n", memtester_cycles_to_ms(test_elapsed));
             } else {
+                fail_summary_print();
+                test_fail_map |= testbit;
                 exit_code |= EXIT_FAIL_OTHERTEST;
                 if (s_memtester_fail_stop)
                   break;
@@ -424,6 +489,25 @@ int memtester_main(ul phystestbase, ul wantraw, char *memsuffix, ul loops, ul pa
         printf("\n");
     }
 
+    mtu_perf_timebase_stop();
+
+    /* Summary of tests that have been run */
+    printf("%-24s %10s  %s\n", "Test", "Time(ms)", "Result");
+    if ((test_pass_map | test_fail_map) & MEMTESTER_TEST_MASK_STUCK_ADDRESS) {
+        printf("%-24s %10d  %s\n", "Stuck Address", memtester_cycles_to_ms(test_cycles[31]),
+               (test_fail_map & MEMTESTER_TEST_MASK_STUCK_ADDRESS) ? "failed" : "ok");
+    }
+    for (i=0; tests[i].name; i++) {
+        testbit = (ul)1 << i;
+        if ((test_pass_map | test_fail_map) & testbit) {
+            printf("%-24s %10d  %s\n", tests[i].name, memtester_cycles_to_ms(test_cycles[i]),
+                   (test_fail_map & testbit) ? "failed" : "ok");
+        }
+    }
+    /* A test that failed in any loop is not in pass bitmap */
+    test_pass_map &= ~test_fail_map;
+    printf("pass bitmap 0x%08x, fail bitmap 0x%08x, random seed 0x%08x\n", test_pass_map, test_fail_map, seed);
+
 #if 1
     if (exit_code)
       printf("Done and Failed!\r\n");
@@ -20,6 +20,24 @@
 #include "fsl_debug_console.h"
 #include "mtu.h"
 
+/* Test mask bit of stuck address test, other bits select tests[] by index.
+   Mask 0 runs all tests. */
+#define MEMTESTER_TEST_MASK_STUCK_ADDRESS (1UL << 31)
+
+/* Stress test packet carries a 16-bit mask: bit i (i < 13) selects tests[i],
+   the bits below select test groups. Mask 0 runs all tests. */
+#define MEMTESTER_PACKET_MASK_TESTS         (0x1FFFU)
+#define MEMTESTER_PACKET_MASK_WALKING_BITS  (1U << 13)
+#define MEMTESTER_PACKET_MASK_NARROW_WRITES (1U << 14)
+#define MEMTESTER_PACKET_MASK_STUCK_ADDRESS (1U << 15)
+
+/* Seed of random patterns, printed in the result. 0 seeds from the cycle
+   counter, set it to a printed seed to replay a failing run. */
+#ifndef MEMTESTER_RANDOM_SEED
+#define MEMTESTER_RANDOM_SEED (0)
+#endif
+#define MEMTESTER_DEFAULT_SEED (0x2545F491UL)
+
 /* extern declarations. */
 
 extern int use_phys;
@@ -15,7 +15,8 @@
 #ifndef __SIZES_H__
 #define __SIZES_H__
 
-#define rand32() ((unsigned int) rand() | ( (unsigned int) rand() << 16))
+/* libc rand() costs more than a bus write per word, use inlined xorshift32 from tests.h */
+#define rand32() rand_xorshift32()
 
 #define ULONG_MAX       (4294967295UL)
 #if (ULONG_MAX == 4294967295UL)
@@ -14,6 +14,7 @@
  */
 
 #include "memtester.h"
+#include "tests.h"
 
 char progress[] = "-\\|/";
 #define PROGRESSLEN 4
@@ -45,25 +46,208 @@ int Dummy_Putchar(int ch)
     return 0;
 }
 
-int compare_regions(ulv *bufa, ulv *bufb, size_t count) {
-    int r = 0;
+/* Failure aggregator. Printing every mismatching word over UART takes far
+   longer than the test itself when a whole DQ lane or address line is bad,
+   so compare_regions() only accumulates here and fail_summary_print() emits
+   one summary per test. */
+struct fail_record {
+    ul offset;
+    ul a;
+    ul b;
+};
+
+static struct {
+    ul total;                                /* mismatching words */
+    ul dq_mask;                              /* OR of all differing bits */
+    ul dq_fails[UL_LEN];                     /* mismatches per data bit */
+    ul addr_fails[UL_LEN];                   /* mismatches whose offset has this address bit set */
+    ul addr_span;                            /* OR of all compared offsets */
+    ul base_a;                               /* start of compared halves */
+    ul base_b;
+    struct fail_record first[FAIL_RECORDS];
+    struct fail_record last[FAIL_RECORDS];   /* ring buffer, last is at (total - 1) % FAIL_RECORDS */
+} fail_summary;
+
+void fail_summary_reset(void) {
+    memset(&fail_summary, 0, sizeof(fail_summary));
+}
+
+static void fail_record_print(const struct fail_record *rec) {
+    if (use_phys) {
+        printf("    0x%08x != 0x%08x at physical address 0x%08x/0x%08x (diff 0x%08x)\n",
+                rec->a, rec->b, fail_summary.base_a + rec->offset,
+                fail_summary.base_b + rec->offset, rec->a ^ rec->b);
+    } else {
+        printf("    0x%08x != 0x%08x at offset 0x%08x (diff 0x%08x)\n",
+                rec->a, rec->b, rec->offset, rec->a ^ rec->b);
+    }
+}
+
+void fail_summary_print(void) {
+    ul i, n;
+
+    if (!fail_summary.total) {
+        return;
+    }
+    printf("FAILURE: %u mismatching words, failing DQ mask 0x%08x\n",
+            fail_summary.total, fail_summary.dq_mask);
+    printf("  DQ fails:");
+    for (i = 0; i < UL_LEN; i++) {
+        if (fail_summary.dq_fails[i]) {
+            printf(" D%u:%u", i, fail_summary.dq_fails[i]);
+        }
+    }
+    printf("\n");
+    /* An address bit that is set (or clear) in all failures points to that
+       address line, it is marked with '!'. A few failures agree on most
+       bits by chance, so marks need FAIL_ADDR_MIN_SAMPLES failures. */
+    printf("  Address bit set in fails:");
+    for (i = 0; i < UL_LEN; i++) {
+        if (fail_summary.addr_span & ((ul)1 << i)) {
+            n = fail_summary.addr_fails[i];
+            printf(" A%u:%u%s", i, n,
+                   ((fail_summary.total >= FAIL_ADDR_MIN_SAMPLES) &&
+                    ((n == 0) || (n == fail_summary.total))) ? "!" : "");
+        }
+    }
+    if (fail_summary.total < FAIL_ADDR_MIN_SAMPLES) {
+        printf(" (insufficient samples)");
+    }
+    printf("\n");
+    n = (fail_summary.total < FAIL_RECORDS) ? fail_summary.total : FAIL_RECORDS;
+    printf("  First %u fails:\n", n);
+    for (i = 0; i < n; i++) {
+        fail_record_print(&fail_summary.first[i]);
+    }
+    if (fail_summary.total > FAIL_RECORDS) {
+        printf("  Last %u fails:\n", n);
+        for (i = fail_summary.total - n; i < fail_summary.total; i++) {
+            fail_record_print(&fail_summary.last[i % FAIL_RECORDS]);
+        }
+    }
+}
+
+static void fail_record_add(ul offset, ul a, ul b) {
+    ul diff;
+    unsigned int bit;
+
+    if (fail_summary.total < FAIL_RECORDS) {
+        fail_summary.first[fail_summary.total].offset = offset;
+        fail_summary.first[fail_summary.total].a = a;
+        fail_summary.first[fail_summary.total].b = b;
+    }
+    fail_summary.last[fail_summary.total % FAIL_RECORDS].offset = offset;
+    fail_summary.last[fail_summary.total % FAIL_RECORDS].a = a;
+    fail_summary.last[fail_summary.total % FAIL_RECORDS].b = b;
+    fail_summary.total++;
+    diff = a ^ b;
+    fail_summary.dq_mask |= diff;
+    for (bit = 0; diff; bit++, diff >>= 1) {
+        if (diff & 1) {
+            fail_summary.dq_fails[bit]++;
+        }
+    }
+    for (bit = 0; offset; bit++, offset >>= 1) {
+        if (offset & 1) {
+            fail_summary.addr_fails[bit]++;
+        }
+    }
+}
+
+/* Random pattern generator state, shared by all tests so a seed replays
+   the whole run. */
+ul rand_state = MEMTESTER_DEFAULT_SEED;
+
+void rand_seed(ul seed) {
+    rand_state = seed ? seed : MEMTESTER_DEFAULT_SEED;
+}
+
+/* Unrolled fill kernels. Every word is still a real (volatile) write, the
+   unrolling only takes loop and pattern overhead off the bus. */
+#define FILL_UNROLL 4
+
+static void fill_random(ulv *bufa, ulv *bufb, size_t count) {
+    ulv *p1 = bufa;
+    ulv *p2 = bufb;
     size_t i;
+    ul q0, q1, q2, q3;
+
+    for (i = 0; i + FILL_UNROLL <= count; i += FILL_UNROLL, p1 += FILL_UNROLL, p2 += FILL_UNROLL) {
+        q0 = rand_ul();
+        q1 = rand_ul();
+        q2 = rand_ul();
+        q3 = rand_ul();
+        p1[0] = p2[0] = q0;
+        p1[1] = p2[1] = q1;
+        p1[2] = p2[2] = q2;
+        p1[3] = p2[3] = q3;
+    }
+    for (; i < count; i++) {
+        *p1++ = *p2++ = rand_ul();
+    }
+}
+
+/* Fill even words with q0 and odd words with q1 */
+static void fill_pattern(ulv *bufa, ulv *bufb, size_t count, ul q0, ul q1) {
     ulv *p1 = bufa;
     ulv *p2 = bufb;
-    off_t physaddr;
+    size_t i;
 
-    for (i = 0; i < count; i++, p1++, p2++) {
-        if (*p1 != *p2) {
-            if (use_phys) {
-                physaddr = physaddrbase + (i * sizeof(ul));
-                printf("FAILURE: 0x%08x != 0x%08x at physical address "
-                        "0x%08x.\n", 
-                        (ul) *p1, (ul) *p2, physaddr);
-            } else {
-                printf("FAILURE: 0x%08x != 0x%08x at offset 0x%08x.\n", 
-                        (ul) *p1, (ul) *p2, (ul) (i * sizeof(ul)));
+    for (i = 0; i + FILL_UNROLL <= count; i += FILL_UNROLL, p1 += FILL_UNROLL, p2 += FILL_UNROLL) {
+        p1[0] = p2[0] = q0;
+        p1[1] = p2[1] = q1;
+        p1[2] = p2[2] = q0;
+        p1[3] = p2[3] = q1;
+    }
+    for (; i < count; i++) {
+        *p1++ = *p2++ = (i % 2) == 0 ? q0 : q1;
+    }
+}
+
+/* Compare 8 words per iteration and only record a block that mismatches,
+   from the values already read, so a transient fail is not lost by a
+   re-read. */
+#define COMPARE_UNROLL 8
+
+int compare_regions(ulv *bufa, ulv *bufb, size_t count) {
+    int r = 0;
+    size_t i, k;
+    ulv *p1 = bufa;
+    ulv *p2 = bufb;
+    ul a[COMPARE_UNROLL], b[COMPARE_UNROLL];
+    ul a0, b0;
+
+    fail_summary.base_a = (ul) bufa;
+    fail_summary.base_b = (ul) bufb;
+    /* Every address bit below the top compared offset is exercised */
+    for (a0 = count ? (count - 1) * sizeof(ul) : 0; a0; a0 >>= 1) {
+        fail_summary.addr_span |= a0 & ~(ul) (sizeof(ul) - 1);
+    }
+    for (i = 0; i + COMPARE_UNROLL <= count; i += COMPARE_UNROLL, p1 += COMPARE_UNROLL, p2 += COMPARE_UNROLL) {
+        a[0] = p1[0]; b[0] = p2[0];
+        a[1] = p1[1]; b[1] = p2[1];
+        a[2] = p1[2]; b[2] = p2[2];
+        a[3] = p1[3]; b[3] = p2[3];
+        a[4] = p1[4]; b[4] = p2[4];
+        a[5] = p1[5]; b[5] = p2[5];
+        a[6] = p1[6]; b[6] = p2[6];
+        a[7] = p1[7]; b[7] = p2[7];
+        if (((a[0] ^ b[0]) | (a[1] ^ b[1]) | (a[2] ^ b[2]) | (a[3] ^ b[3]) |
+             (a[4] ^ b[4]) | (a[5] ^ b[5]) | (a[6] ^ b[6]) | (a[7] ^ b[7])) == 0) {
+            continue;
+        }
+        for (k = 0; k < COMPARE_UNROLL; k++) {
+            if (a[k] != b[k]) {
+                fail_record_add((i + k) * sizeof(ul), a[k], b[k]);
             }
-            /* printf("Skipping to next test..."); */
+        }
+        r = -1;
+    }
+    for (; i < count; i++, p1++, p2++) {
+        a0 = *p1;
+        b0 = *p2;
+        if (a0 != b0) {
+            fail_record_add(i * sizeof(ul), a0, b0);
             r = -1;
         }
     }
@@ -110,19 +294,8 @@ int test_stuck_address(ulv *bufa, size_t count) {
 }
 
 int test_random_value(ulv *bufa, ulv *bufb, size_t count) {
-    ulv *p1 = bufa;
-    ulv *p2 = bufb;
-    ul j = 0;
-    size_t i;
-
     KPUTCHAR(' ');
-    for (i = 0; i < count; i++) {
-        *p1++ = *p2++ = rand_ul();
-        if (!(i % PROGRESSOFTEN)) {
-            KPUTCHAR('\b');
-            KPUTCHAR(progress[++j % PROGRESSLEN]);
-        }
-    }
+    fill_random(bufa, bufb, count);
     Kprintf("\b \b");
     return compare_regions(bufa, bufb, count);
 }
@@ -221,22 +394,15 @@ int test_seqinc_comparison(ulv *bufa, ulv *bufb, size_t count) {
 }
 
 int test_solidbits_comparison(ulv *bufa, ulv *bufb, size_t count) {
-    ulv *p1 = bufa;
-    ulv *p2 = bufb;
     unsigned int j;
     ul q;
-    size_t i;
 
     Kprintf("           ");
     for (j = 0; j < 64; j++) {
         Kprintf("\b\b\b\b\b\b\b\b\b\b\b");
         q = (j % 2) == 0 ? UL_ONEBITS : 0;
         Kprintf("setting %3u", j);
-        p1 = (ulv *) bufa;
-        p2 = (ulv *) bufb;
-        for (i = 0; i < count; i++) {
-            *p1++ = *p2++ = (i % 2) == 0 ? q : ~q;
-        }
+        fill_pattern(bufa, bufb, count, q, ~q);
         Kprintf("\b\b\b\b\b\b\b\b\b\b\b");
         Kprintf("testing %3u", j);
         if (compare_regions(bufa, bufb, count)) {
@@ -248,22 +414,15 @@ int test_solidbits_comparison(ulv *bufa, ulv *bufb, size_t count) {
 }
 
 int test_checkerboard_comparison(ulv *bufa, ulv *bufb, size_t count) {
-    ulv *p1 = bufa;
-    ulv *p2 = bufb;
     unsigned int j;
     ul q;
-    size_t i;
 
     Kprintf("           ");
     for (j = 0; j < 64; j++) {
         Kprintf("\b\b\b\b\b\b\b\b\b\b\b");
         q = (j % 2) == 0 ? CHECKERBOARD1 : CHECKERBOARD2;
         Kprintf("setting %3u", j);
-        p1 = (ulv *) bufa;
-        p2 = (ulv *) bufb;
-        for (i = 0; i < count; i++) {
-            *p1++ = *p2++ = (i % 2) == 0 ? q : ~q;
-        }
+        fill_pattern(bufa, bufb, count, q, ~q);
         Kprintf("\b\b\b\b\b\b\b\b\b\b\b");
         Kprintf("testing %3u", j);
         if (compare_regions(bufa, bufb, count)) {
@@ -275,20 +434,13 @@ int test_checkerboard_comparison(ulv *bufa, ulv *bufb, size_t count) {
 }
 
 int test_blockseq_comparison(ulv *bufa, ulv *bufb, size_t count) {
-    ulv *p1 = bufa;
-    ulv *p2 = bufb;
     unsigned int j;
-    size_t i;
 
     Kprintf("           ");
     for (j = 0; j < 256; j++) {
         Kprintf("\b\b\b\b\b\b\b\b\b\b\b");
-        p1 = (ulv *) bufa;
-        p2 = (ulv *) bufb;
         Kprintf("setting %3u", j);
-        for (i = 0; i < count; i++) {
-            *p1++ = *p2++ = (ul) UL_BYTE(j);
-        }
+        fill_pattern(bufa, bufb, count, (ul) UL_BYTE(j), (ul) UL_BYTE(j));
         Kprintf("\b\b\b\b\b\b\b\b\b\b\b");
         Kprintf("testing %3u", j);
         if (compare_regions(bufa, bufb, count)) {
@@ -300,24 +452,19 @@ int test_blockseq_comparison(ulv *bufa, ulv *bufb, size_t count) {
 }
 
 int test_walkbits0_comparison(ulv *bufa, ulv *bufb, size_t count) {
-    ulv *p1 = bufa;
-    ulv *p2 = bufb;
     unsigned int j;
-    size_t i;
+    ul q;
 
     Kprintf("           ");
     for (j = 0; j < UL_LEN * 2; j++) {
         Kprintf("\b\b\b\b\b\b\b\b\b\b\b");
-        p1 = (ulv *) bufa;
-        p2 = (ulv *) bufb;
         Kprintf("setting %3u", j);
-        for (i = 0; i < count; i++) {
-            if (j < UL_LEN) { /* Walk it up. */
-                *p1++ = *p2++ = ONE << j;
-            } else { /* Walk it back down. */
-                *p1++ = *p2++ = ONE << (UL_LEN * 2 - j - 1);
-            }
+        if (j < UL_LEN) { /* Walk it up. */
+            q = ONE << j;
+        } else { /* Walk it back down. */
+            q = ONE << (UL_LEN * 2 - j - 1);
         }
+        fill_pattern(bufa, bufb, count, q, q);
         Kprintf("\b\b\b\b\b\b\b\b\b\b\b");
         Kprintf("testing %3u", j);
         if (compare_regions(bufa, bufb, count)) {
@@ -329,24 +476,19 @@ int test_walkbits0_comparison(ulv *bufa, ulv *bufb, size_t count) {
 }
 
 int test_walkbits1_comparison(ulv *bufa, ulv *bufb, size_t count) {
-    ulv *p1 = bufa;
-    ulv *p2 = bufb;
     unsigned int j;
-    size_t i;
+    ul q;
 
     Kprintf("           ");
     for (j = 0; j < UL_LEN * 2; j++) {
         Kprintf("\b\b\b\b\b\b\b\b\b\b\b");
-        p1 = (ulv *) bufa;
-        p2 = (ulv *) bufb;
         Kprintf("setting %3u", j);
-        for (i = 0; i < count; i++) {
-            if (j < UL_LEN) { /* Walk it up. */
-                *p1++ = *p2++ = UL_ONEBITS ^ (ONE << j);
-            } else { /* Walk it back down. */
-                *p1++ = *p2++ = UL_ONEBITS ^ (ONE << (UL_LEN * 2 - j - 1));
-            }
+        if (j < UL_LEN) { /* Walk it up. */
+            q = UL_ONEBITS ^ (ONE << j);
+        } else { /* Walk it back down. */
+            q = UL_ONEBITS ^ (ONE << (UL_LEN * 2 - j - 1));
         }
+        fill_pattern(bufa, bufb, count, q, q);
         Kprintf("\b\b\b\b\b\b\b\b\b\b\b");
         Kprintf("testing %3u", j);
         if (compare_regions(bufa, bufb, count)) {
@@ -358,30 +500,19 @@ int test_walkbits1_comparison(ulv *bufa, ulv *bufb, size_t count) {
 }
 
 int test_bitspread_comparison(ulv *bufa, ulv *bufb, size_t count) {
-    ulv *p1 = bufa;
-    ulv *p2 = bufb;
     unsigned int j;
-    size_t i;
+    ul q;
 
     Kprintf("           ");
     for (j = 0; j < UL_LEN * 2; j++) {
         Kprintf("\b\b\b\b\b\b\b\b\b\b\b");
-        p1 = (ulv *) bufa;
-        p2 = (ulv *) bufb;
         Kprintf("setting %3u", j);
-        for (i = 0; i < count; i++) {
-            if (j < UL_LEN) { /* Walk it up. */
-                *p1++ = *p2++ = (i % 2 == 0)
-                    ? (ONE << j) | (ONE << (j + 2))
-                    : UL_ONEBITS ^ ((ONE << j)
-                                    | (ONE << (j + 2)));
-            } else { /* Walk it back down. */
-                *p1++ = *p2++ = (i % 2 == 0)
-                    ? (ONE << (UL_LEN * 2 - 1 - j)) | (ONE << (UL_LEN * 2 + 1 - j))
-                    : UL_ONEBITS ^ (ONE << (UL_LEN * 2 - 1 - j)
-                                    | (ONE << (UL_LEN * 2 + 1 - j)));
-            }
+        if (j < UL_LEN) { /* Walk it up. */
+            q = (ONE << j) | (ONE << (j + 2));
+        } else { /* Walk it back down. */
+            q = (ONE << (UL_LEN * 2 - 1 - j)) | (ONE << (UL_LEN * 2 + 1 - j));
         }
+        fill_pattern(bufa, bufb, count, q, UL_ONEBITS ^ q);
         Kprintf("\b\b\b\b\b\b\b\b\b\b\b");
         Kprintf("testing %3u", j);
         if (compare_regions(bufa, bufb, count)) {
@@ -393,11 +524,8 @@ int test_bitspread_comparison(ulv *bufa, ulv *bufb, size_t count) {
 }
 
 int test_bitflip_comparison(ulv *bufa, ulv *bufb, size_t count) {
-    ulv *p1 = bufa;
-    ulv *p2 = bufb;
     unsigned int j, k;
     ul q;
-    size_t i;
 
     Kprintf("           ");
     for (k = 0; k < UL_LEN; k++) {
@@ -406,11 +534,7 @@ int test_bitflip_comparison(ulv *bufa, ulv *bufb, size_t count) {
             Kprintf("\b\b\b\b\b\b\b\b\b\b\b");
             q = ~q;
             Kprintf("setting %3u", k * 8 + j);
-            p1 = (ulv *) bufa;
-            p2 = (ulv *) bufb;
-            for (i = 0; i < count; i++) {
-                *p1++ = *p2++ = (i % 2) == 0 ? q : ~q;
-            }
+            fill_pattern(bufa, bufb, count, q, ~q);
             Kprintf("\b\b\b\b\b\b\b\b\b\b\b");
             Kprintf("testing %3u", k * 8 + j);
             if (compare_regions(bufa, bufb, count)) {
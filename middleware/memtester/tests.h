@@ -21,6 +21,28 @@
 
 #include "types.h"
 
+/* Number of first/last failing words kept by failure aggregator */
+#define FAIL_RECORDS 8
+
+/* Failures needed before an address bit common to all of them is marked */
+#define FAIL_ADDR_MIN_SAMPLES 8
+
+/* Random pattern generator, state must never be 0 */
+extern ul rand_state;
+
+static inline ul rand_xorshift32(void) {
+    ul x = rand_state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    rand_state = x;
+    return x;
+}
+
+void rand_seed(ul seed);
+
+void fail_summary_reset(void);
+void fail_summary_print(void);
 int test_stuck_address(ulv *bufa, size_t count);
 int test_random_value(ulv *bufa, ulv *bufb, size_t count);
 int test_xor_comparison(ulv *bufa, ulv *bufb, size_t count);